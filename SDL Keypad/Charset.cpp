@@ -0,0 +1,110 @@
+#include "Charset.h"
+
+Charset::Charset(const string & symbols)
+{
+	//	Re-encode while decoding, so malformed input ends up as valid replacement characters
+	size_t position = 0;
+	char utf8[4];
+	while(position < symbols.size() && codePoints.size() < CHARSET_MAX_LENGTH)
+	{
+		Uint32 codePoint;
+		if(!DecodeUtf8(symbols, position, codePoint))
+			codePoint = 0xFFFD;
+
+		offsets.push_back((Uint32)text.size());
+		codePoints.push_back(codePoint);
+		text.append(utf8, EncodeUtf8(codePoint, utf8));
+	}
+	offsets.push_back((Uint32)text.size());
+}
+
+int Charset::Find(Uint32 codePoint) const
+{
+	for(size_t c = 0; c < codePoints.size(); c++)
+		if(codePoints[c] == codePoint)
+			return (int)c;
+
+	return -1;
+}
+
+string Charset::Encode(const Code & code) const
+{
+	string encoded;
+	for(const CharIndex & c : code)
+		if(c < codePoints.size())
+			encoded.append(GetSymbol(c), GetSymbolLength(c));
+
+	return encoded;
+}
+
+bool Charset::DecodeUtf8(const string & text, size_t & position, Uint32 & codePoint)
+{
+	//	Decodes one code point and moves past it, fails on malformed sequences
+	const Uint8 lead = (Uint8)text[position++];
+	int continuation;
+	if(lead < 0x80)
+	{
+		codePoint = lead;
+		return true;
+	}
+	else if((lead & 0xE0) == 0xC0)
+	{
+		codePoint = lead & 0x1F;
+		continuation = 1;
+	}
+	else if((lead & 0xF0) == 0xE0)
+	{
+		codePoint = lead & 0x0F;
+		continuation = 2;
+	}
+	else if((lead & 0xF8) == 0xF0)
+	{
+		codePoint = lead & 0x07;
+		continuation = 3;
+	}
+	else
+		return false;
+
+	for(int c = 0; c < continuation; c++)
+	{
+		if(position >= text.size() || ((Uint8)text[position] & 0xC0) != 0x80)
+			return false;
+		codePoint = (codePoint << 6) | ((Uint8)text[position++] & 0x3F);
+	}
+
+	return true;
+}
+
+/*
+ * Writes the UTF-8 encoding of a code point, returns its
+ * length in bytes. Invalid code points become U+FFFD.
+ */
+size_t Charset::EncodeUtf8(Uint32 codePoint, char * utf8)
+{
+	if(codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+		codePoint = 0xFFFD;
+
+	if(codePoint < 0x80)
+	{
+		utf8[0] = (char)codePoint;
+		return 1;
+	}
+	if(codePoint < 0x800)
+	{
+		utf8[0] = (char)(0xC0 | (codePoint >> 6));
+		utf8[1] = (char)(0x80 | (codePoint & 0x3F));
+		return 2;
+	}
+	if(codePoint < 0x10000)
+	{
+		utf8[0] = (char)(0xE0 | (codePoint >> 12));
+		utf8[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+		utf8[2] = (char)(0x80 | (codePoint & 0x3F));
+		return 3;
+	}
+	utf8[0] = (char)(0xF0 | (codePoint >> 18));
+	utf8[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+	utf8[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+	utf8[3] = (char)(0x80 | (codePoint & 0x3F));
+	return 4;
+}
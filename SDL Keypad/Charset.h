@@ -0,0 +1,61 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (only types and macros, no SDL runtime is needed here)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Symbols are indexed by CharIndex, longer charsets are truncated
+#define CHARSET_MAX_LENGTH 0xFFFF
+#pragma endregion
+
+//	A slot of the charset, codes are sequences of slots
+typedef Uint16 CharIndex;
+typedef vector<CharIndex> Code;
+
+/*
+ * The symbols a code can be made of, in wheel order.
+ * The UTF-8 text it's built from is decoded once: each slot
+ * keeps its code point and where its encoding sits in the
+ * text, so the symbol in any slot is available in constant
+ * time and can be handed as is to the label cache, with no
+ * decoding while the game runs.
+ * Malformed sequences become U+FFFD, one slot each.
+ */
+class Charset
+{
+	// Fields
+public:
+protected:
+private:
+	string text;
+	vector<Uint32> codePoints;
+	vector<Uint32> offsets;	//	Where each symbol starts in text, plus the end of the text
+	// Constructors
+public:
+	explicit Charset(const string & symbols);
+protected:
+private:
+	// Methods
+public:
+	__inline int GetLength() const { return (int)codePoints.size(); }
+	__inline bool IsEmpty() const { return codePoints.empty(); }
+	__inline const string & GetText() const { return text; }
+	__inline Uint32 GetCodePoint(int slot) const { return codePoints[slot]; }
+	__inline const char * GetSymbol(int slot) const { return text.data() + offsets[slot]; }
+	__inline size_t GetSymbolLength(int slot) const { return offsets[slot + 1] - offsets[slot]; }
+	int Find(Uint32 codePoint) const;
+	string Encode(const Code & code) const;
+	static bool DecodeUtf8(const string & text, size_t & position, Uint32 & codePoint);
+	static size_t EncodeUtf8(Uint32 codePoint, char * utf8);
+protected:
+private:
+};
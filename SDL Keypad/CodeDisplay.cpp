@@ -2,6 +2,8 @@
 
 #pragma region Game Includes
 #include "Utilities.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
 #pragma endregion
 
 #pragma region Constant Parameters
@@ -10,19 +12,21 @@
 #pragma endregion
 
 CodeDisplay::CodeDisplay(
+	const Charset & charset,
 	const int & digitsCount, const int & digitSpacing,
 	const SDL_Color & neutralColor, const SDL_Color & deleteColor
 ) :
+	charset(charset),
 	digitsCount(digitsCount),
 	digitSpacing(digitSpacing),
 	neutralColor(neutralColor),
 	deleteColor(deleteColor)
 { }
 
-void CodeDisplay::SetDigits(const string & newDigits, vector<SDL_Color> * colors)
+void CodeDisplay::SetDigits(const Code & newDigits, vector<SDL_Color> * colors)
 {
 	//	Update digits
-	digits = newDigits.substr(0,digitsCount);
+	digits.assign(newDigits.begin(), newDigits.begin() + SDL_min((int)newDigits.size(), digitsCount));
 
 	//	Flush colors since a new code has been provided
 	digitsColors.clear();
@@ -31,6 +35,9 @@ void CodeDisplay::SetDigits(const string & newDigits, vector<SDL_Color> * colors
 	if(colors)
 		for(const SDL_Color & color : *colors)
 			digitsColors.push_back(color);
+
+	//	What's cached isn't up to date anymore
+	layer.Invalidate();
 }
 
 void CodeDisplay::BeginInteraction(const SDL_Point & point)
@@ -55,6 +62,8 @@ void CodeDisplay::BeginInteraction(const SDL_Point & point)
 
 void CodeDisplay::Render(SDL_Renderer * r) const
 {
+	TRACE_SCOPE("CodeDisplay::Render");
+
 	//	Check viewport aera is valid
 	SDL_Rect const * areaPtr = GetViewportArea();
 
@@ -64,6 +73,12 @@ void CodeDisplay::Render(SDL_Renderer * r) const
 
 	const SDL_Rect & area = *areaPtr;
 
+	//	Draw once, then copy from the cache until the code changes
+	layer.Draw(r, area, [this](SDL_Renderer * target, const SDL_Rect & layerArea) { return RenderLayer(target, layerArea); });
+}
+
+bool CodeDisplay::RenderLayer(SDL_Renderer * r, const SDL_Rect & area) const
+{
 	//	Prepare data for rendering
 	const int digitSize = GetDigitSize(area);
 	const int inputLength = (int)digits.size();
@@ -72,22 +87,23 @@ void CodeDisplay::Render(SDL_Renderer * r) const
 
 	//	Render code digits
 	SDL_Rect targetArea;
-	string digit;
+	static const char missingChar = MISSING_CHAR;
+	bool ready = true;
 	for(int d = 0; d < digitsCount; d++)
 	{
 		//	Calculate the target area for this digit
 		GetDigitArea(area, d, targetArea);
 
-		//	Prepare the current input digit or use the missing character if the digit in this place has not been input yet
-		if(d < inputLength)
-			digit = {digits[d]};
-		else
-			digit = {MISSING_CHAR};
-		
+		//	Point to the current input symbol or to the missing character if the digit in this place has not been input yet
+		const bool hasDigit = d < inputLength;
+		const char * digit = hasDigit ? charset.GetSymbol(digits[d]) : &missingChar;
+		const size_t digitLength = hasDigit ? charset.GetSymbolLength(digits[d]) : 1;
+
 		//	Render the digit in the current place
-		RenderLabel(
+		ready &= RenderLabel(
 			r,
 			digit,
+			digitLength,
 			targetArea.x + targetArea.w / 2,
 			targetArea.y + targetArea.h / 2,
 			isFull && d < colorsSize ? digitsColors[d] : neutralColor,
@@ -98,9 +114,11 @@ void CodeDisplay::Render(SDL_Renderer * r) const
 	//	Render the delete button (cross in a square shape)
 	GetDeleteArea(area, targetArea);
 	SDL_SetRenderDrawColor(r, deleteColor.r, deleteColor.g, deleteColor.b, deleteColor.a);
-	SDL_RenderDrawRect(r, &targetArea);
-	SDL_RenderDrawLine(r, targetArea.x, targetArea.y, targetArea.x + targetArea.w, targetArea.y + targetArea.h);
-	SDL_RenderDrawLine(r, targetArea.x + targetArea.w, targetArea.y, targetArea.x, targetArea.y + targetArea.h);
+	StatsRenderDrawRect(r, &targetArea);
+	StatsRenderDrawLine(r, targetArea.x, targetArea.y, targetArea.x + targetArea.w, targetArea.y + targetArea.h);
+	StatsRenderDrawLine(r, targetArea.x + targetArea.w, targetArea.y, targetArea.x, targetArea.y + targetArea.h);
+
+	return ready;
 }
 
 int CodeDisplay::GetDigitSize(const SDL_Rect & area) const
@@ -13,6 +13,8 @@
 #pragma region Game Includes
 #include "IRenderable.h"
 #include "IInteractable.h"
+#include "LayerCache.h"
+#include "Charset.h"
 #pragma endregion
 
 using namespace std;
@@ -22,6 +24,7 @@ using namespace std;
  * a fixed amount of digits (decided at construction time).
  * Additionally, it handles input to implement a "clear"
  * button that can flush the input code.
+ * Digits are charset slots, drawn with the charset symbols.
  * This is the only place where the input code is stored. For
  * this reason, the "clear" button effects are applied internally
  * without the need to coordinate with a controller.
@@ -34,33 +37,37 @@ class CodeDisplay : public IRenderable, public IInteractable
 public:
 protected:
 private:
+	const Charset charset;
 	const int digitsCount;
 	const int digitSpacing;
-	string digits;
+	Code digits;
 	vector<SDL_Color> digitsColors;
 	const SDL_Color neutralColor;
 	const SDL_Color deleteColor;
+	mutable LayerCache layer;	//	Digits and delete button only change on input
 	// Constructors
 public:
-	CodeDisplay(const int & digitsCount, const int & digitSpacing, const SDL_Color & neutralColor, const SDL_Color & deleteColor);
+	CodeDisplay(const Charset & charset, const int & digitsCount, const int & digitSpacing, const SDL_Color & neutralColor, const SDL_Color & deleteColor);
 protected:
 private:
 	// Methods
 public:
 	__inline bool IsFull() const { return digits.size() == digitsCount; }
-	__inline const string & GetDigits() const { return digits; }
-	void SetDigits(const string & newDigits, vector<SDL_Color> * colors = nullptr);
-	__inline void Clear() { SetDigits(""); }
+	__inline const Code & GetDigits() const { return digits; }
+	void SetDigits(const Code & newDigits, vector<SDL_Color> * colors = nullptr);
+	__inline void Clear() { SetDigits(Code()); }
 
 	//	IInteractable implementation
 	void BeginInteraction(const SDL_Point & point) override;
 	void EndInteraction() override { }
-	void MoveInteraction(const SDL_Point & from, const SDL_Point & to) override { }
+	void MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp) override { }
 
 	//	IRenderable implementation
 	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override { return IDLE_FOREVER; }	//	Only changes on input
 protected:
 private:
+	bool RenderLayer(SDL_Renderer * r, const SDL_Rect & area) const;
 	int GetDigitSize(const SDL_Rect & area) const;
 	int GetCodeExtent(const SDL_Rect & area) const;
 	void GetDigitArea(const SDL_Rect & area, const int digit, SDL_Rect & digitArea) const;
@@ -0,0 +1,59 @@
+#include "FrameClock.h"
+
+FrameClock::FrameClock() :
+	realTicks(SDL_GetTicks64()),
+	ticks(realTicks),	//	Game time starts aligned with SDL time, so early readers don't see a jump
+	deltaTicks(0),
+	carryTicks(0.0),
+	timeScale(1.0f),
+	paused(false),
+	virtualSource(false),
+	virtualTicks(0)
+{ }
+
+void FrameClock::Sample()
+{
+	//	Read the source once, everything else this frame derives from this value
+	const Uint64 now = ReadSource();
+	const Uint64 realDelta = now > realTicks ? now - realTicks : 0;
+	realTicks = now;
+
+	//	Paused time doesn't flow at all, scaled time keeps the fractional part for the next frame
+	if(paused)
+	{
+		deltaTicks = 0;
+		return;
+	}
+
+	const double scaledDelta = realDelta * (double)timeScale + carryTicks;
+	deltaTicks = (Uint64)scaledDelta;
+	carryTicks = scaledDelta - (double)deltaTicks;
+	ticks += deltaTicks;
+}
+
+void FrameClock::SetVirtual(bool enabled)
+{
+	/*
+	 * Switching source must not move game time: the virtual
+	 * source resumes from the current real time and vice versa,
+	 * only the source changes.
+	 */
+	if(enabled == virtualSource)
+		return;
+
+	if(enabled)
+		virtualTicks = realTicks;
+	else
+		realTicks = SDL_GetTicks64();
+
+	virtualSource = enabled;
+}
+
+Uint64 FrameClock::ToRealTicks(Uint64 gameTicks) const
+{
+	//	How long a span of game time lasts in real time (forever when time doesn't flow)
+	if(paused || timeScale <= 0.0f || gameTicks == (Uint64)-1)
+		return (Uint64)-1;
+
+	return (Uint64)(gameTicks / (double)timeScale);
+}
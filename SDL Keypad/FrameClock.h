@@ -0,0 +1,54 @@
+#pragma once
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+/*
+ * A clock sampled once per frame by the main loop.
+ * Every game element reads the time from here instead of
+ * asking SDL directly, so all the parts of a frame (input,
+ * logic, render) agree on what time it is, and only one
+ * system call per frame is made.
+ * Game time can be paused and scaled, and the clock can be
+ * switched to a virtual source that only moves when told to,
+ * which makes timed logic testable step by step.
+ */
+class FrameClock
+{
+	// Fields
+public:
+protected:
+private:
+	Uint64 realTicks;		//	Unscaled source time at the last sample
+	Uint64 ticks;			//	Game time (paused and scaled) at the last sample
+	Uint64 deltaTicks;		//	Game time elapsed between the last two samples
+	double carryTicks;		//	Sub-millisecond remainder left by time scaling
+	float timeScale;
+	bool paused;
+	bool virtualSource;
+	Uint64 virtualTicks;
+	// Constructors
+public:
+	FrameClock();
+protected:
+private:
+	// Methods
+public:
+	void Sample();
+	__inline Uint64 GetTicks() const { return ticks; }
+	__inline Uint64 GetDeltaTicks() const { return deltaTicks; }
+	__inline Uint64 GetRealTicks() const { return realTicks; }
+	__inline void SetPaused(bool pause) { paused = pause; }
+	__inline bool IsPaused() const { return paused; }
+	__inline void SetTimeScale(float scale) { timeScale = scale < 0.0f ? 0.0f : scale; }
+	__inline float GetTimeScale() const { return timeScale; }
+	Uint64 ToRealTicks(Uint64 gameTicks) const;
+	void SetVirtual(bool enabled);
+	__inline bool IsVirtual() const { return virtualSource; }
+	__inline void AdvanceVirtual(Uint64 milliseconds) { virtualTicks += milliseconds; }
+protected:
+private:
+	__inline Uint64 ReadSource() const { return virtualSource ? virtualTicks : SDL_GetTicks64(); }
+};
@@ -0,0 +1,261 @@
+#include "FramePacer.h"
+
+#pragma region C++ Includes
+#include <cmath>
+#include <iomanip>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	A frame missed its deadline when it took this much longer than planned
+#define PACER_MISS_RATIO 1.5
+//	Used when the display doesn't tell its refresh rate
+#define PACER_DEFAULT_REFRESH_RATE 60
+#pragma endregion
+
+FramePacer::FramePacer() :
+	mode(PRESENT_SLEEP),
+	renderer(nullptr),
+	targetFrameTime(1.0 / PACER_DEFAULT_REFRESH_RATE),
+	refreshTime(1.0 / PACER_DEFAULT_REFRESH_RATE),
+	counterFrequency(SDL_GetPerformanceFrequency()),
+	frameStart(0),
+	lastPresent(0),
+	vsyncOn(false),
+	adaptiveFrames(0),
+	adaptiveMisses(0),
+	lastFrameTime(0.0),
+	lastInterval(0.0)
+{
+	ResetStats();
+}
+
+bool FramePacer::ParseMode(const string & name, PresentMode & parsedMode)
+{
+	if(name == "vsync")
+		parsedMode = PRESENT_VSYNC;
+	else if(name == "sleep")
+		parsedMode = PRESENT_SLEEP;
+	else if(name == "busy")
+		parsedMode = PRESENT_BUSY;
+	else if(name == "uncapped")
+		parsedMode = PRESENT_UNCAPPED;
+	else if(name == "adaptive")
+		parsedMode = PRESENT_ADAPTIVE;
+	else
+		return false;
+
+	return true;
+}
+
+const char * FramePacer::GetModeName(PresentMode presentMode)
+{
+	switch(presentMode)
+	{
+		case PRESENT_VSYNC:
+			return "vsync";
+		case PRESENT_SLEEP:
+			return "sleep";
+		case PRESENT_BUSY:
+			return "busy";
+		case PRESENT_UNCAPPED:
+			return "uncapped";
+		case PRESENT_ADAPTIVE:
+			return "adaptive";
+	}
+
+	return "unknown";
+}
+
+void FramePacer::SetMode(PresentMode presentMode)
+{
+	mode = presentMode;
+	adaptiveFrames = 0;
+	adaptiveMisses = 0;
+
+	//	Once attached, switch vsync right away
+	if(renderer)
+		SetVSync(mode == PRESENT_VSYNC || mode == PRESENT_ADAPTIVE);
+}
+
+Uint32 FramePacer::GetRendererFlags() const
+{
+	//	Some renderers can't switch vsync after creation, ask for it upfront
+	Uint32 flags = SDL_RENDERER_ACCELERATED;
+	if(mode == PRESENT_VSYNC || mode == PRESENT_ADAPTIVE)
+		flags |= SDL_RENDERER_PRESENTVSYNC;
+	return flags;
+}
+
+void FramePacer::Attach(SDL_Window * window, SDL_Renderer * r)
+{
+	renderer = r;
+
+	//	Learn the display refresh interval, to tell when vsync frames are late
+	SDL_DisplayMode displayMode;
+	if(SDL_GetWindowDisplayMode(window, &displayMode) == 0 && displayMode.refresh_rate > 0)
+		refreshTime = 1.0 / displayMode.refresh_rate;
+
+	SetMode(mode);
+}
+
+void FramePacer::BeginFrame()
+{
+	frameStart = SDL_GetPerformanceCounter();
+}
+
+void FramePacer::OnPresent()
+{
+	const Uint64 now = SDL_GetPerformanceCounter();
+	bool late = false;
+
+	lastFrameTime = GetSeconds(frameStart, now);
+	lastInterval = 0.0;
+	if(lastPresent != 0)
+	{
+		const double interval = GetSeconds(lastPresent, now);
+		lastInterval = interval;
+		intervals++;
+		intervalSum += interval;
+		intervalSquaresSum += interval * interval;
+		if(interval < intervalMin)
+			intervalMin = interval;
+		if(interval > intervalMax)
+			intervalMax = interval;
+
+		//	Uncapped frames have no deadline to miss
+		const double expected = vsyncOn ? refreshTime : targetFrameTime;
+		if(mode != PRESENT_UNCAPPED && interval > expected * PACER_MISS_RATIO)
+		{
+			missedFrames++;
+			late = true;
+		}
+	}
+	lastPresent = now;
+
+	/*
+	 * With vsync on, a late frame shows up as a long interval.
+	 * With vsync off, present doesn't block: a frame is late when
+	 * its work alone didn't fit a refresh interval.
+	 */
+	if(mode == PRESENT_ADAPTIVE)
+		UpdateAdaptive(vsyncOn ? late : GetSeconds(frameStart, now) > refreshTime);
+}
+
+void FramePacer::Wait()
+{
+	/*
+	 * FPS regulation is entrusted to the browser for webgl
+	 * builds, and present already waited in vsync modes.
+	 */
+#ifndef __EMSCRIPTEN__
+	if(mode == PRESENT_UNCAPPED || vsyncOn)
+		return;
+
+	/*
+	 * Wait for the target frame time, counted from the frame
+	 * start. Frames taking longer have two roads to walk:
+	 * - variable frame time: we just don't wait and rush into the next frame
+	 * - fixed frame time (FRAME_SKIP): we skip to the next fixed frame slot
+	 */
+	double elapsed = GetSeconds(frameStart, SDL_GetPerformanceCounter());
+#ifdef FRAME_SKIP
+	elapsed = fmod(elapsed, targetFrameTime);
+#endif
+	const double remaining = targetFrameTime - elapsed;
+	if(remaining <= 0.0)
+		return;
+
+	const Uint64 deadline = SDL_GetPerformanceCounter() + (Uint64)(remaining * counterFrequency);
+	if(mode == PRESENT_BUSY)
+	{	//	Spin: precise to the microsecond, at the cost of a core
+		while(SDL_GetPerformanceCounter() < deadline)
+			;
+	}
+	else
+	{	//	Sleep: the OS scheduler may oversleep by a millisecond or so
+		SDL_Delay((Uint32)(remaining * 1000.0));
+	}
+#endif
+}
+
+double FramePacer::GetFps() const
+{
+	return intervalSum > 0.0 ? intervals / intervalSum : 0.0;
+}
+
+double FramePacer::GetJitter() const
+{
+	if(intervals < 2)
+		return 0.0;
+
+	const double mean = intervalSum / intervals;
+	const double variance = intervalSquaresSum / intervals - mean * mean;
+	return variance > 0.0 ? sqrt(variance) : 0.0;
+}
+
+void FramePacer::ResetStats()
+{
+	intervals = 0;
+	intervalSum = 0.0;
+	intervalSquaresSum = 0.0;
+	intervalMin = 1e30;
+	intervalMax = 0.0;
+	missedFrames = 0;
+	lastPresent = 0;
+}
+
+void FramePacer::PrintReport(ostream & out) const
+{
+	out << "Presentation (" << GetModeName(mode);
+	if(mode == PRESENT_ADAPTIVE)
+		out << ", vsync " << (vsyncOn ? "on" : "off");
+	out << ", " << intervals << " frames)" << endl;
+	if(intervals == 0)
+		return;
+
+	out << fixed << setprecision(2);
+	out << "	fps " << GetFps() << endl;
+	out << "	frame " << intervalSum / intervals * 1000.0 << " ms";
+	out << " (min " << intervalMin * 1000.0 << ", max " << intervalMax * 1000.0 << ")" << endl;
+	out << "	jitter " << GetJitter() * 1000.0 << " ms" << endl;
+	out << "	missed " << missedFrames << endl;
+}
+
+void FramePacer::SetVSync(bool enabled)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	if(SDL_RenderSetVSync(renderer, enabled ? 1 : 0) == 0)
+	{
+		vsyncOn = enabled;
+		return;
+	}
+#endif
+
+	//	Can't switch: go by what the renderer was created with
+	SDL_RendererInfo info;
+	vsyncOn = SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+}
+
+void FramePacer::UpdateAdaptive(bool late)
+{
+	/*
+	 * Over a window of frames, count the late ones. With vsync
+	 * on, a late frame waits for a whole extra refresh, so after
+	 * a few of them vsync is turned off and late frames are shown
+	 * right away. Once frames fit again, vsync comes back.
+	 */
+	adaptiveFrames++;
+	if(late)
+		adaptiveMisses++;
+
+	if(adaptiveFrames < PACER_ADAPTIVE_WINDOW)
+		return;
+
+	if(vsyncOn && adaptiveMisses >= PACER_ADAPTIVE_MISSES_OFF)
+		SetVSync(false);
+	else if(!vsyncOn && adaptiveMisses <= PACER_ADAPTIVE_MISSES_ON)
+		SetVSync(true);
+
+	adaptiveFrames = 0;
+	adaptiveMisses = 0;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <ostream>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Adaptive mode: frames looked at before deciding, and how many late ones turn vsync off
+#define PACER_ADAPTIVE_WINDOW 60
+#define PACER_ADAPTIVE_MISSES_OFF 6
+#define PACER_ADAPTIVE_MISSES_ON 1
+#pragma endregion
+
+/*
+ * How frames are handed to the screen and spaced in time:
+ * - vsync: present blocks until the display refresh
+ * - sleep: sleep until the next frame slot
+ * - busy: spin until the next frame slot (precise, burns a core)
+ * - uncapped: no waiting at all, for benchmarks
+ * - adaptive: vsync while frames keep up with the refresh, sleep
+ *   pacing (tearing late frames instead of halving the frame
+ *   rate) when too many frames miss their deadline
+ */
+enum PresentMode
+{
+	PRESENT_VSYNC,
+	PRESENT_SLEEP,
+	PRESENT_BUSY,
+	PRESENT_UNCAPPED,
+	PRESENT_ADAPTIVE
+};
+
+/*
+ * Applies the presentation policy and measures the intervals
+ * between presents, reporting the achieved frame rate and
+ * jitter (standard deviation of the frame interval), so the
+ * best mode for a device can be picked by numbers.
+ * Timing uses the high resolution performance counter.
+ */
+class FramePacer
+{
+	// Fields
+public:
+protected:
+private:
+	PresentMode mode;
+	SDL_Renderer * renderer;
+	double targetFrameTime;		//	Seconds, for the sleep and busy modes
+	double refreshTime;			//	Seconds, display refresh interval
+	Uint64 counterFrequency;
+	Uint64 frameStart;
+	Uint64 lastPresent;
+	bool vsyncOn;
+
+	//	Adaptive mode
+	int adaptiveFrames;
+	int adaptiveMisses;
+
+	//	Stats (seconds)
+	Uint64 intervals;
+	double intervalSum;
+	double intervalSquaresSum;
+	double intervalMin;
+	double intervalMax;
+	Uint64 missedFrames;
+	double lastFrameTime;		//	Begin of the frame to present, waits excluded
+	double lastInterval;		//	Between the last two presents, 0 after an idle wait
+	// Constructors
+public:
+	FramePacer();
+protected:
+private:
+	// Methods
+public:
+	static bool ParseMode(const string & name, PresentMode & parsedMode);
+	static const char * GetModeName(PresentMode presentMode);
+
+	void SetMode(PresentMode presentMode);
+	__inline PresentMode GetMode() const { return mode; }
+	__inline void SetTargetFps(int fps) { targetFrameTime = fps > 0 ? 1.0 / fps : 0.0; }
+	Uint32 GetRendererFlags() const;
+	void Attach(SDL_Window * window, SDL_Renderer * r);
+
+	void BeginFrame();
+	void OnPresent();
+	void Wait();
+	__inline void OnIdle() { lastPresent = 0; }	//	The loop slept on purpose, don't count the gap as a frame
+
+	double GetFps() const;
+	double GetJitter() const;
+	__inline Uint64 GetMissedFrames() const { return missedFrames; }
+	__inline double GetLastFrameTime() const { return lastFrameTime; }
+	__inline double GetLastInterval() const { return lastInterval; }
+	void ResetStats();
+	void PrintReport(ostream & out) const;
+protected:
+private:
+	__inline double GetSeconds(Uint64 from, Uint64 to) const { return (double)(to - from) / counterFrequency; }
+	void SetVSync(bool enabled);
+	void UpdateAdaptive(bool late);
+};
@@ -2,6 +2,8 @@
 
 #pragma region Engine Includes
 #include "Utilities.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
 #pragma endregion
 
 GameOverScreen::GameOverScreen(const SDL_Color & winBackColor, const SDL_Color & loseBackColor, const SDL_Color & foregroundColor) :
@@ -26,6 +28,8 @@ void GameOverScreen::BeginInteraction(const SDL_Point & point)
 
 void GameOverScreen::Render(SDL_Renderer * r) const
 {
+	TRACE_SCOPE("GameOverScreen::Render");
+
 	//	Check viewport aera is valid
 	SDL_Rect const * areaPtr = GetViewportArea();
 
@@ -35,14 +39,21 @@ void GameOverScreen::Render(SDL_Renderer * r) const
 
 	const SDL_Rect & area = *areaPtr;
 
+	//	Draw once, then copy from the cache until the outcome changes
+	layer.Draw(r, area, [this](SDL_Renderer * target, const SDL_Rect & layerArea) { return RenderLayer(target, layerArea); });
+}
+
+bool GameOverScreen::RenderLayer(SDL_Renderer * r, const SDL_Rect & area) const
+{
 	//	Fill screen
 	const SDL_Color & backColor = success ? winBackColor : loseBackColor;
 	SDL_SetRenderDrawColor(r, backColor.r, backColor.g, backColor.b, backColor.a);
-	SDL_RenderFillRect(r, &area);
-	const string message = success ? "YOU SAVED THE WORLD!!" : "BOOOOOM!!!!!";
-	RenderLabel(
+	StatsRenderFillRect(r, &area);
+	const char * message = success ? "YOU SAVED THE WORLD!!" : "BOOOOOM!!!!!";
+	return RenderLabel(
 		r,
 		message,
+		SDL_strlen(message),
 		area.x + area.w / 2,
 		area.y + area.h / 2,
 		foregroundColor,
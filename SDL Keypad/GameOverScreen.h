@@ -3,6 +3,7 @@
 #pragma region Game Includes
 #include "IRenderable.h"
 #include "IInteractable.h"
+#include "LayerCache.h"
 #pragma endregion
 
 /*
@@ -25,6 +26,7 @@ private:
 	const SDL_Color loseBackColor;
 	const SDL_Color foregroundColor;
 	bool skipRequested;
+	mutable LayerCache layer;	//	Background and message only change with the outcome
 	// Constructors
 public:
 	GameOverScreen(const SDL_Color & winBackColor, const SDL_Color & loseBackColor, const SDL_Color & foregroundColor);
@@ -32,17 +34,19 @@ protected:
 private:
 	// Methods
 public:
-	void SetSuccess(bool won) { success = won; }
+	void SetSuccess(bool won) { if(won != success) layer.Invalidate(); success = won; }
 	bool PeekSkipRequested() const { return skipRequested; }
 	bool ConsumeSkipRequested();
 
 	//	IInteractable implementation
 	void BeginInteraction(const SDL_Point & point) override;
 	void EndInteraction() override { }	//	Unused
-	void MoveInteraction(const SDL_Point & from, const SDL_Point & to) override { }	//	Unused
+	void MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp) override { }	//	Unused
 
 	//	IRenderable implementation
 	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override { return IDLE_FOREVER; }	//	Only changes on input
 protected:
 private:
+	bool RenderLayer(SDL_Renderer * r, const SDL_Rect & area) const;
 };
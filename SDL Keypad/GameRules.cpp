@@ -0,0 +1,73 @@
+#include "GameRules.h"
+
+#pragma region C++ Includes
+#include <cstdlib>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Error assigned to digits that haven't been provided yet
+#define MISSING_DIGIT_ERROR 9
+#pragma endregion
+
+GameRules::GameRules(
+	const Charset & charset, const Uint8 & codeLength,
+	const Uint8 & stages, const Uint32 & stageTimeMilliseconds
+) :
+	charset(charset),
+	charsetLength(charset.GetLength()),
+	codeLength(codeLength),
+	stages(stages),
+	solveTime(stageTimeMilliseconds * stages),
+	stagesLeft(stages)
+{
+	/*
+	 * The wheel distance only depends on how far apart the two
+	 * indices are: one entry per gap, the shortest way around,
+	 * saturated so far slots of large charsets never look close.
+	 */
+	distances.resize(charsetLength > 0 ? charsetLength : 1, 0);
+	for(int gap = 1; gap < charsetLength; gap++)
+		distances[gap] = (Uint8)SDL_min(SDL_min(gap, charsetLength - gap), 0xFF);
+}
+
+Uint8 GameRules::GetCharacterError(const CharIndex input, const CharIndex expected) const
+{
+	return distances[abs((int)input - (int)expected)];
+}
+
+void GameRules::EvaluateCodeError(const Code & codeInput, Uint8 * digitErrors) const
+{
+	const int inputSize = (int)codeInput.size();
+
+	/*
+	 * Set the error for each digit to the distance of the input digit
+	 * from the requested digit. If the digit has not been provided,
+	 * set the error to an arbitrary high distance (relevant ditances
+	 * are 0 for match, 1 for almost match and > 1 for wrong).
+	 * The caller provides the output buffer (at least codeLength
+	 * elements) so simulations can evaluate guesses without
+	 * allocating.
+	 */
+	for(int c = 0; c < codeLength; c++)
+	{
+		if(c < inputSize)
+			digitErrors[c] = GetCharacterError(codeInput[c], code[c]);
+		else
+			digitErrors[c] = (Uint8)MISSING_DIGIT_ERROR;
+	}
+}
+
+vector<Uint8> GameRules::EvaluateCodeError(const Code & codeInput) const
+{
+	vector<Uint8> digitErrors(codeLength);
+
+	EvaluateCodeError(codeInput, digitErrors.data());
+
+	return digitErrors;
+}
+
+float GameRules::GetTimeLeft(const Uint64 elapsedMilliseconds) const
+{
+	//	Return a normalized representation of the remaining time
+	return 1.0f - SDL_clamp((float)elapsedMilliseconds / solveTime, 0.0f, 1.0f);
+}
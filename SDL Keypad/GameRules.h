@@ -0,0 +1,122 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (only types and macros, no SDL runtime is needed here)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Charset.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * This class holds the pure rules of the game: the charset,
+ * the code to guess, how a guess is evaluated and how stages
+ * progress when a code is submitted.
+ * It doesn't know anything about rendering, input or the
+ * system clock, so it can be used both by the game (through
+ * GameState) and by offline tools that simulate thousands
+ * of games per second (e.g. the difficulty calibration tool).
+ * Randomness is injected by the caller: anything callable as
+ * randomIndex(length), returning a number in [0, length),
+ * can be used to generate codes.
+ * Codes are sequences of charset slots, so the rules work the
+ * same whatever symbols the charset is made of: the error of
+ * a digit is how far the wheel is from the right slot, going
+ * around it either way (the first and last slots are close).
+ */
+class GameRules
+{
+	// Fields
+public:
+protected:
+private:
+	const Charset charset;
+	const int charsetLength;
+	const Uint8 codeLength;
+	const Uint8 stages;
+	const Uint32 solveTime;
+	vector<Uint8> distances;	//	Wheel distance between two slots, by how far apart their indices are
+	Code code;
+	Uint8 stagesLeft;
+	// Constructors
+public:
+	GameRules(
+		const Charset & charset, const Uint8 & codeLength,
+		const Uint8 & stages, const Uint32 & stageTimeMilliseconds
+	);
+protected:
+private:
+	// Methods
+public:
+	__inline const Charset & GetCharset() const { return charset; }
+	__inline int GetCharsetLength() const { return charsetLength; }
+	__inline Uint8 GetCodeLength() const { return codeLength; }
+	__inline Uint8 GetStages() const { return stages; }
+	__inline Uint8 GetStagesLeft() const { return stagesLeft; }
+	__inline Uint32 GetSolveTime() const { return solveTime; }
+	__inline const Code & GetCode() const { return code; }
+	__inline void SetCode(const Code & newCode) { code = newCode; }
+	template<typename IndexSource> void Restart(IndexSource & randomIndex);
+	template<typename IndexSource> void GenerateNewCode(IndexSource & randomIndex);
+	__inline bool IsFullCode(const Code & codeInput) const { return codeInput.size() == codeLength; }
+	Uint8 GetCharacterError(const CharIndex input, const CharIndex expected) const;
+	void EvaluateCodeError(const Code & codeInput, Uint8 * digitErrors) const;
+	vector<Uint8> EvaluateCodeError(const Code & codeInput) const;
+	__inline bool CheckCode(const Code & codeInput) const { return code == codeInput; }
+	template<typename IndexSource> bool SubmitCode(const Code & codeInput, IndexSource & randomIndex);
+	float GetTimeLeft(const Uint64 elapsedMilliseconds) const;
+	__inline bool IsTimeUp(const Uint64 elapsedMilliseconds) const { return elapsedMilliseconds >= solveTime; }
+	__inline bool AreStagesCleared() const { return stagesLeft < 1; }
+protected:
+private:
+};
+
+/*
+ * Template methods are defined here since they must be visible
+ * to any caller, whatever random source they bring along.
+ */
+
+template<typename IndexSource>
+void GameRules::Restart(IndexSource & randomIndex)
+{
+	//	Reset game progress
+	stagesLeft = stages;
+
+	//	Generate a new code
+	GenerateNewCode(randomIndex);
+}
+
+template<typename IndexSource>
+void GameRules::GenerateNewCode(IndexSource & randomIndex)
+{
+	code.resize(codeLength);
+
+	for(int c = 0; c < codeLength; c++)
+		code[c] = (CharIndex)randomIndex(charsetLength);
+}
+
+template<typename IndexSource>
+bool GameRules::SubmitCode(const Code & codeInput, IndexSource & randomIndex)
+{
+	const bool match = CheckCode(codeInput);
+
+	//	If the code just provided matches the requested one (and there are any more stages left), advance one stage and prepare for next
+	if(
+		match &&
+		stagesLeft > 0
+	)
+	{
+		stagesLeft--;
+		GenerateNewCode(randomIndex);
+	}
+
+	return match;
+}
@@ -1,12 +1,9 @@
 #include "GameState.h"
 
-#pragma region C++ Includes
-#include <sstream>
-#include <cmath>
-#pragma endregion
-
 #pragma region Game Includes
 #include "Utilities.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
 #pragma endregion
 
 #pragma region Constant Parameters
@@ -20,11 +17,8 @@ GameState::GameState(
 	const Uint8 & stages, const Uint32 & stageTimeMilliseconds,
 		const SDL_Color & primaryColor, const SDL_Color & accentColor
 ) :
-	charset(charset),
-	charsetLength((int)charset.size()),
-	codeLength(codeLength),
-	stages(stages),
-	solveTime(stageTimeMilliseconds * stages),
+	rules(Charset(charset), codeLength, stages, stageTimeMilliseconds),
+	clock(nullptr),
 	primaryColor(primaryColor),
 	accentColor(accentColor)
 {
@@ -32,76 +26,43 @@ GameState::GameState(
 	Restart();
 }
 
-void GameState::Restart()
+void GameState::SetClock(const FrameClock & frameClock)
 {
-	//	Reset game progress
-	timerStart = SDL_GetTicks64();
-	stagesLeft = stages;
-
-	//	Generate a new code
-	GenerateNewCode();
+	//	Keep the elapsed time when moving from one time base to the other
+	const Uint64 elapsed = GetNow() - timerStart;
+	clock = &frameClock;
+	const Uint64 now = GetNow();
+	timerStart = now > elapsed ? now - elapsed : 0;
 }
 
-void GameState::GenerateNewCode()
+void GameState::Restart()
 {
-	ostringstream codeBuffer;
-
-	for(int c = 0; c < codeLength; c++)
-		codeBuffer << charset[GetRandomIndex(charsetLength)];
-
-	code = codeBuffer.str();
+	//	Reset game progress and generate a new code
+	timerStart = GetNow();
+	rules.Restart(GetRandomIndex);
 }
 
-vector<Uint8> GameState::EvaluateCodeError(const string & codeInput) const
+void GameState::GenerateNewCode()
 {
-	const int inputSize = (int)codeInput.size();
-	vector<Uint8> digitErrors;
-
-	/*
-	 * Set the error for each digit to the distance of the input digit
-	 * from the requested digit. If the digit has not been provided,
-	 * set the error to an arbitrary high distance (relevant ditances
-	 * are 0 for match, 1 for almost match and > 1 for wrong).
-	 */
-	for(int c = 0; c < codeLength; c++)
-	{
-		if(c < inputSize)
-			digitErrors.push_back((Uint8)abs((int)codeInput[c] - (int)code[c]));
-		else
-			digitErrors.push_back((Uint8)9);
-	}
-
-	return digitErrors;
+	rules.GenerateNewCode(GetRandomIndex);
 }
 
-bool GameState::SubmitCode(const string & codeInput)
+bool GameState::SubmitCode(const Code & codeInput)
 {
-	const bool match = CheckCode(codeInput);
-
-	//	If the code just provided matches the requested one (and there are any more stages left), advance one stage and prepare for next
-	if(
-		match &&
-		stagesLeft > 0
-	)
-	{
-		stagesLeft--;
-		GenerateNewCode();
-	}
-
-	return match;
+	return rules.SubmitCode(codeInput, GetRandomIndex);
 }
 
 float GameState::GetTimeLeft() const
 {
-	//	Calculate the remaining time
-	Uint32 timeLeft = (Uint32)(SDL_GetTicks64() - timerStart);
-
-	//	Return a normalized representation of the remaining time
-	return 1.0f - SDL_clamp((float)timeLeft / solveTime, 0.0f, 1.0f);
+	//	Calculate the elapsed time and let the rules normalize it
+	const Uint64 now = GetNow();
+	return rules.GetTimeLeft(now > timerStart ? now - timerStart : 0);
 }
 
 void GameState::Render(SDL_Renderer * r) const
 {
+	TRACE_SCOPE("GameState::Render");
+
 	//	Check viewport aera is valid
 	SDL_Rect const * areaPtr = GetViewportArea();
 
@@ -115,7 +76,7 @@ void GameState::Render(SDL_Renderer * r) const
 	SDL_Rect targetArea;
 
 	//	Render stages
-	for(int s = 0; s < stagesLeft; s++)
+	for(int s = 0; s < rules.GetStagesLeft(); s++)
 	{
 		GetStageArea(area, s, targetArea);
 		RenderBar(r, targetArea);
@@ -126,9 +87,32 @@ void GameState::Render(SDL_Renderer * r) const
 	RenderBar(r, targetArea);
 }
 
+Uint64 GameState::GetIdleTime() const
+{
+	//	Nothing moves once the game is over
+	SDL_Rect const * areaPtr = GetViewportArea();
+	if(!areaPtr || IsGameOver())
+		return IDLE_FOREVER;
+
+	/*
+	 * The timer bar is the only thing moving on its own: it
+	 * will look the same until it shrinks by one pixel, that
+	 * happens when elapsed time reaches
+	 *	solveTime * (width - currentWidth) / width
+	 * (time running out included, at zero width).
+	 */
+	const int width = areaPtr->w > 0 ? areaPtr->w : 1;
+	const int currentWidth = (int)(GetTimeLeft() * width);
+	const Uint64 now = GetNow();
+	const Uint64 elapsed = now > timerStart ? now - timerStart : 0;
+	const Uint64 nextChange = ((Uint64)rules.GetSolveTime() * (width - currentWidth) + width - 1) / width;
+
+	return nextChange > elapsed ? nextChange - elapsed : 0;
+}
+
 void GameState::GetStageArea(const SDL_Rect & area, const int sector, SDL_Rect & stageArea) const
 {
-	const int stagePortion = area.w / stages;
+	const int stagePortion = area.w / rules.GetStages();
 
 	stageArea.w = stagePortion - BARS_THCKNESS;
 	stageArea.h = BARS_THCKNESS;
@@ -148,9 +132,9 @@ void GameState::RenderBar(SDL_Renderer * r, const SDL_Rect & area) const
 {
 	//	Render fill
 	SDL_SetRenderDrawColor(r, accentColor.r, accentColor.g, accentColor.b, accentColor.a);
-	SDL_RenderFillRect(r, &area);
+	StatsRenderFillRect(r, &area);
 
 	//	Render border
 	SDL_SetRenderDrawColor(r, primaryColor.r, primaryColor.g, primaryColor.b, primaryColor.a);
-	SDL_RenderDrawRect(r, &area);
+	StatsRenderDrawRect(r, &area);
 }
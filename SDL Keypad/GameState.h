@@ -12,6 +12,8 @@
 
 #pragma region Game Includes
 #include "IRenderable.h"
+#include "GameRules.h"
+#include "FrameClock.h"
 #pragma endregion
 
 using namespace std;
@@ -22,6 +24,8 @@ using namespace std;
  * the game HUD (that's why it implements IRenderable)
  * and stores the main game information such as the code
  * to input and the game progression.
+ * The rules themselves live in GameRules, this class binds
+ * them to the real time and to the screen.
  */
 class GameState : public IRenderable
 {
@@ -29,13 +33,8 @@ class GameState : public IRenderable
 public:
 protected:
 private:
-	const string charset;
-	const int charsetLength;
-	const Uint8 codeLength;
-	string code;
-	const Uint8 stages;
-	Uint8 stagesLeft;
-	const Uint32 solveTime;
+	GameRules rules;
+	FrameClock const * clock;
 	Uint64 timerStart;
 	const SDL_Color primaryColor;
 	const SDL_Color accentColor;
@@ -50,24 +49,28 @@ protected:
 private:
 	// Methods
 public:
-	__inline const string & GetCharset() const { return charset; }
+	void SetClock(const FrameClock & frameClock);
+	__inline const GameRules & GetRules() const { return rules; }
+	__inline const Charset & GetCharset() const { return rules.GetCharset(); }
 	void Restart();
 	void GenerateNewCode();
-	__inline Uint8 GetCodeLength() const { return codeLength; }
-	__inline bool IsFullCode(const string & code) const { return code.size() == codeLength; }
-	vector<Uint8> EvaluateCodeError(const string & codeInput) const;
-	__inline bool CheckCode(const string & codeInput) const { return code == codeInput; }
-	bool SubmitCode(const string & codeInput);
+	__inline Uint8 GetCodeLength() const { return rules.GetCodeLength(); }
+	__inline bool IsFullCode(const Code & code) const { return rules.IsFullCode(code); }
+	__inline vector<Uint8> EvaluateCodeError(const Code & codeInput) const { return rules.EvaluateCodeError(codeInput); }
+	__inline bool CheckCode(const Code & codeInput) const { return rules.CheckCode(codeInput); }
+	bool SubmitCode(const Code & codeInput);
 	float GetTimeLeft() const;
 	__inline bool IsTimeUp() const { return GetTimeLeft() <= 0.0f; }
-	__inline bool AreStagesCleared() const { return stagesLeft < 1; }
+	__inline bool AreStagesCleared() const { return rules.AreStagesCleared(); }
 	__inline bool IsGameOver() const { return IsTimeUp() || AreStagesCleared(); }
 	__inline bool IsGameOn() const { return !IsGameOver(); }
 
 	//	IRenderable implementation
 	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override;
 protected:
 private:
+	__inline Uint64 GetNow() const { return clock ? clock->GetTicks() : SDL_GetTicks64(); }
 	void GetStageArea(const SDL_Rect & area, const int sector, SDL_Rect & stageArea) const;
 	void GetTimerArea(const SDL_Rect & area, SDL_Rect & timerArea) const;
 	void RenderBar(SDL_Renderer * r, const SDL_Rect & area) const;
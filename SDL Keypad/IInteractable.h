@@ -15,13 +15,15 @@
  * Anything that will need to respond to mouse/touch
  * will need to implement this interface and add itself
  * to the interaciton queue, right before the main loop.
+ * Moves carry the SDL timestamp of their event, so whoever
+ * applies them can report it for latency measurements.
  */
 class IInteractable : virtual public IViewportElement
 {
 public:
 	virtual void BeginInteraction(const SDL_Point & point) = 0;
 	virtual void EndInteraction() = 0;
-	virtual void MoveInteraction(const SDL_Point & from, const SDL_Point & to) = 0;
+	virtual void MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp) = 0;
 protected:
 	virtual bool IsInteractionAllowed() const { return true; }
 };
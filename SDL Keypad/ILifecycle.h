@@ -1,16 +1,48 @@
 #pragma once
 
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+/*
+ * Stages of the main loop where lifecycle code can run, in
+ * the order they're executed within a frame.
+ */
+enum class FramePhase : Uint8
+{
+	FrameStart,
+	FrameInitialization,
+	PreEventsLoop,
+	PreRender,
+	PostRenderClear,
+	PreRenderPresent,
+	PostRenderPresent,
+	FrameEnd,
+	Count
+};
+
+//	Phases as bit flags, to tell which hooks an implementation actually uses
+#define PHASE_BIT(phase) ((Uint32)1 << (Uint32)(phase))
+#define ALL_PHASES (PHASE_BIT(FramePhase::Count) - 1)
+
 /*
  * Interface used by the main loop to dispatch lifecycle
  * messages.
  * Anything that will need to execute code at specific
  * stages of the main loop will need to implement this
- * interface and add itself to the lifecycle queue,
+ * interface and register itself to the phase scheduler,
  * right before the main loop.
+ * Only the hooks listed by GetLifecyclePhases() are
+ * scheduled, so implementations should override it to
+ * skip the hooks they leave empty.
  */
 class ILifecycle
 {
 public:
+	//	Which of the hooks below are implemented (PHASE_BIT flags)
+	virtual Uint32 GetLifecyclePhases() const { return ALL_PHASES; }
+
 	//	Called at frame start, even before the FPS regulation initialization (heavy operations here may break the frame rate steadiness)
 	virtual void OnFrameStart() { }
 	//	Called at fram initialization, right after the viewport size was updated
@@ -9,15 +9,25 @@
 #include "IViewportElement.h"
 #pragma endregion
 
+#pragma region Constant Parameters
+//	Idle time of elements that only change on input
+#define IDLE_FOREVER ((Uint64)-1)
+#pragma endregion
+
 /*
  * Interface used by the main loop to dispatch render
  * messages.
  * Anything that will need to appear on-screen will
  * need to implement this interface and add itself
  * to the render queue, right before the main loop.
+ * Renderables also tell for how long (in game ticks) they
+ * would keep drawing the same image if no input came, so
+ * the main loop can sleep instead of redrawing: by default
+ * they're assumed to change every frame.
  */
 class IRenderable : virtual public IViewportElement
 {
 public:
 	virtual void Render(SDL_Renderer * r) const = 0;
+	virtual Uint64 GetIdleTime() const { return 0; }
 };
@@ -0,0 +1,343 @@
+#include "JobSystem.h"
+
+#pragma region Game Includes
+#include "TraceLog.h"
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Failed attempts to find a job before a worker goes to sleep
+#define IDLE_SPINS_BEFORE_SLEEP 64
+#pragma endregion
+
+/*
+ * Each thread remembers which job system it belongs to and its
+ * slot in it, so pushing and allocating never need a lookup.
+ */
+static thread_local JobSystem const * currentSystem = nullptr;
+static thread_local int currentThreadIndex = -1;
+
+JobSystem::JobSystem() :
+	queues(nullptr),
+	pools(nullptr),
+	threadsCount(0),
+	queuedJobs(0),
+	sleepingWorkers(0),
+	stopping(false)
+{
+	//	Usable right away, everything running on the owner thread
+	Start(0);
+}
+
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+void JobSystem::Start(int workersCount)
+{
+	Stop();
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	workersCount = 0;
+#endif
+	if(workersCount < 0)
+		workersCount = 0;
+
+	threadsCount = workersCount + 1;
+	queues = new WorkQueue[threadsCount];
+	for(int q = 0; q < threadsCount; q++)
+		queues[q].front = queues[q].back = 0;
+	pools = new JobPool[threadsCount + 1];
+	for(int p = 0; p <= threadsCount; p++)
+	{
+		pools[p].nextRoot = 0;
+		pools[p].freeList = nullptr;
+		AddRootBlock(pools[p]);
+	}
+
+	//	The calling thread takes the first slot
+	currentSystem = this;
+	currentThreadIndex = 0;
+
+	stopping = false;
+	for(int w = 1; w <= workersCount; w++)
+		workers.push_back(thread(&JobSystem::WorkerLoop, this, w));
+}
+
+void JobSystem::Stop()
+{
+	if(!queues)
+		return;
+
+	{
+		lock_guard<mutex> lock(sleepLock);
+		stopping = true;
+	}
+	wakeUp.notify_all();
+	for(thread & worker : workers)
+		worker.join();
+	workers.clear();
+
+	//	Drain whatever nobody waited for, so payloads are destroyed
+	Job * job;
+	while((job = GetJob(0)) != nullptr)
+		Execute(job);
+
+	//	Children migrate between free lists, but each block is owned by the pool that allocated it
+	for(int p = 0; p <= threadsCount; p++)
+	{
+		for(Job * block : pools[p].rootBlocks)
+			delete[] block;
+		for(Job * block : pools[p].blocks)
+			delete[] block;
+	}
+	delete[] pools;
+	delete[] queues;
+	pools = nullptr;
+	queues = nullptr;
+	threadsCount = 0;
+
+	if(currentSystem == this)
+	{
+		currentSystem = nullptr;
+		currentThreadIndex = -1;
+	}
+}
+
+Job * JobSystem::Create(void (*function)(Job * job), Job * parent)
+{
+	Job * job = AllocateJob(parent == nullptr);
+	job->function = function;
+	job->destroy = nullptr;
+	job->parent = parent;
+	job->unfinished.store(1, memory_order_relaxed);
+
+	//	A parent isn't finished until all its children are
+	if(parent)
+		parent->unfinished.fetch_add(1, memory_order_relaxed);
+
+	return job;
+}
+
+void JobSystem::Run(Job * job)
+{
+	int threadIndex = GetThreadIndex();
+
+	//	Threads unknown to this system hand their jobs over to the first queue
+	if(threadIndex < 0)
+		threadIndex = 0;
+
+	//	A full queue means plenty of work is waiting already: this job doesn't wait too
+	bool queued = false;
+	{
+		WorkQueue & queue = queues[threadIndex];
+		lock_guard<mutex> lock(queue.lock);
+		if(queue.back - queue.front < JOB_QUEUE_SIZE)
+		{
+			queue.jobs[queue.back++ & (JOB_QUEUE_SIZE - 1)] = job;
+			queued = true;
+		}
+	}
+	if(!queued)
+	{
+		Execute(job);
+		return;
+	}
+	queuedJobs.fetch_add(1);
+
+	//	Only pay for a notification when someone is actually sleeping (sequentially consistent, pairs with the worker going to sleep)
+	if(sleepingWorkers.load() > 0)
+	{
+		lock_guard<mutex> lock(sleepLock);
+		wakeUp.notify_one();
+	}
+}
+
+void JobSystem::Wait(const Job * job)
+{
+	const int threadIndex = GetThreadIndex();
+
+	//	Help instead of blocking: the awaited job may be one of those we run
+	while(!IsFinished(job))
+	{
+		Job * next = GetJob(threadIndex);
+		if(next)
+			Execute(next);
+		else
+			this_thread::yield();
+	}
+}
+
+int JobSystem::GetThreadIndex() const
+{
+	return currentSystem == this ? currentThreadIndex : -1;
+}
+
+Job * JobSystem::AllocateJob(bool root)
+{
+	const int threadIndex = GetThreadIndex();
+
+	//	Foreign threads share the last pool, under lock
+	unique_lock<mutex> lock(externalLock, defer_lock);
+	if(threadIndex < 0)
+		lock.lock();
+	JobPool & pool = pools[threadIndex < 0 ? threadsCount : threadIndex];
+
+	if(root)
+	{
+		//	Roots: ring allocation, an unfinished root may still be queued or waited on so it is skipped
+		const size_t capacity = pool.rootBlocks.size() * JOB_ROOTS_POOL_SIZE;
+		for(size_t probe = 0; probe < capacity; probe++)
+		{
+			const size_t slot = pool.nextRoot;
+			pool.nextRoot = (slot + 1) % capacity;
+			Job * job = &pool.rootBlocks[slot / JOB_ROOTS_POOL_SIZE][slot % JOB_ROOTS_POOL_SIZE];
+			if(IsFinished(job))
+				return job;
+		}
+
+		//	Every root is still in use: grow the ring, the next allocations start with the new block
+		AddRootBlock(pool);
+		pool.nextRoot = capacity + 1;
+		return &pool.rootBlocks.back()[0];
+	}
+
+	//	Children: recycled ones first, a new block only when the free list is empty
+	if(!pool.freeList)
+	{
+		Job * block = new Job[JOB_BLOCK_SIZE];
+		pool.blocks.push_back(block);
+		for(int j = 0; j < JOB_BLOCK_SIZE; j++)
+		{
+			block[j].nextFree = pool.freeList;
+			pool.freeList = &block[j];
+		}
+	}
+
+	Job * job = pool.freeList;
+	pool.freeList = job->nextFree;
+	return job;
+}
+
+void JobSystem::AddRootBlock(JobPool & pool)
+{
+	//	Slots are free until a root is created in them
+	Job * block = new Job[JOB_ROOTS_POOL_SIZE];
+	for(int j = 0; j < JOB_ROOTS_POOL_SIZE; j++)
+		block[j].unfinished.store(0, memory_order_relaxed);
+	pool.rootBlocks.push_back(block);
+}
+
+void JobSystem::ReleaseJob(Job * job)
+{
+	const int threadIndex = GetThreadIndex();
+
+	unique_lock<mutex> lock(externalLock, defer_lock);
+	if(threadIndex < 0)
+		lock.lock();
+	JobPool & pool = pools[threadIndex < 0 ? threadsCount : threadIndex];
+
+	job->nextFree = pool.freeList;
+	pool.freeList = job;
+}
+
+Job * JobSystem::GetJob(int threadIndex)
+{
+	if(queuedJobs.load(memory_order_acquire) < 1)
+		return nullptr;
+
+	Job * job = nullptr;
+
+	//	Own queue first, newest job (LIFO)
+	if(threadIndex >= 0)
+	{
+		WorkQueue & own = queues[threadIndex];
+		lock_guard<mutex> lock(own.lock);
+		if(own.back != own.front)
+			job = own.jobs[--own.back & (JOB_QUEUE_SIZE - 1)];
+	}
+
+	//	Then steal the oldest job from the others (FIFO), starting from the next thread to spread contention
+	for(int offset = 1; !job && offset <= threadsCount; offset++)
+	{
+		const int victim = ((threadIndex < 0 ? 0 : threadIndex) + offset) % threadsCount;
+		if(victim == threadIndex)
+			continue;
+
+		WorkQueue & other = queues[victim];
+		lock_guard<mutex> lock(other.lock);
+		if(other.back != other.front)
+			job = other.jobs[other.front++ & (JOB_QUEUE_SIZE - 1)];
+	}
+
+	if(job)
+		queuedJobs.fetch_sub(1, memory_order_relaxed);
+
+	return job;
+}
+
+void JobSystem::Execute(Job * job)
+{
+	job->function(job);
+	if(job->destroy)
+		job->destroy(job);
+	Finish(job);
+}
+
+void JobSystem::Finish(Job * job)
+{
+	/*
+	 * The last one out finishes the parent too. Finished children
+	 * go straight back to the pool: nobody can be waiting on them.
+	 * The parent is read first, a finished root may be reused by
+	 * its thread at any time.
+	 */
+	while(job)
+	{
+		Job * parent = job->parent;
+		if(job->unfinished.fetch_sub(1, memory_order_acq_rel) != 1)
+			break;
+		if(parent)
+			ReleaseJob(job);
+		job = parent;
+	}
+}
+
+void JobSystem::WorkerLoop(int threadIndex)
+{
+	currentSystem = this;
+	currentThreadIndex = threadIndex;
+
+	//	Label the worker in traces, when tracing
+	TraceLog * log = GetTraceLog();
+	if(log)
+		log->NameCurrentThread("Job Worker");
+
+	int idleSpins = 0;
+	while(!stopping.load(memory_order_acquire))
+	{
+		Job * job = GetJob(threadIndex);
+		if(job)
+		{
+			Execute(job);
+			idleSpins = 0;
+			continue;
+		}
+
+		//	Spin a little (new jobs usually come in bursts), then sleep until something is queued
+		if(++idleSpins < IDLE_SPINS_BEFORE_SLEEP)
+		{
+			this_thread::yield();
+			continue;
+		}
+
+		unique_lock<mutex> lock(sleepLock);
+		sleepingWorkers.fetch_add(1);
+		wakeUp.wait(lock, [this]()
+		{
+			return stopping.load() || queuedJobs.load() > 0;
+		});
+		sleepingWorkers.fetch_sub(1);
+		idleSpins = 0;
+	}
+}
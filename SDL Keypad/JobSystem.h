@@ -0,0 +1,213 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <cstddef>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Bytes available to store a job's payload (lambdas captures must fit here)
+#define JOB_PAYLOAD_SIZE 48
+//	Root jobs in each block of a thread's ring (grown by a block when all of them are unfinished)
+#define JOB_ROOTS_POOL_SIZE 1024
+//	Child jobs allocated at once when a thread runs out of recycled ones
+#define JOB_BLOCK_SIZE 256
+//	Jobs each thread can have queued at once (power of two), more run right away on the thread that queues them
+#define JOB_QUEUE_SIZE 4096
+#pragma endregion
+
+class JobSystem;
+
+/*
+ * A unit of work.
+ * A job is finished when its own work and the work of all its
+ * children is done, so waiting on a parent waits on a whole
+ * tree of jobs.
+ * Only jobs without a parent (roots) can be waited on: children
+ * are recycled as soon as they finish.
+ */
+struct Job
+{
+	void (*function)(Job * job);
+	void (*destroy)(Job * job);
+	Job * parent;
+	Job * nextFree;
+	atomic<int> unfinished;
+	alignas(alignof(max_align_t)) unsigned char payload[JOB_PAYLOAD_SIZE];
+};
+
+/*
+ * Work-stealing job system.
+ * Every thread taking part (the main thread plus the workers)
+ * owns a queue: the owner pushes and pops jobs at the back
+ * (LIFO, cache friendly), idle threads steal from the front of
+ * other queues (FIFO, oldest and usually largest jobs first).
+ * Queues are fixed rings of JOB_QUEUE_SIZE jobs: queuing never
+ * allocates, and a job that finds its queue full simply runs
+ * right away.
+ * Waiting on a job never blocks the waiting thread: it keeps
+ * executing other jobs until the awaited one is finished.
+ * Workers sleep when there's nothing to do, so an idle job
+ * system costs nothing.
+ * With no workers (or without threads support, e.g. emscripten
+ * without pthreads) jobs simply run on the thread that waits
+ * for them.
+ * Jobs are pooled per thread, so creating one doesn't touch the
+ * heap once the pools are warm: children go back to a free list
+ * when finished, roots come from a ring (they must stay readable
+ * while someone waits on them). The ring hands out the oldest
+ * finished slot and skips unfinished ones, so a finished root is
+ * only reused once its thread went round the whole ring. If no
+ * slot is finished, the ring grows by JOB_ROOTS_POOL_SIZE roots
+ * instead of overwriting one.
+ */
+class JobSystem
+{
+	// Fields
+public:
+protected:
+private:
+	typedef struct
+	{
+		mutex lock;
+		Job * jobs[JOB_QUEUE_SIZE];
+		unsigned int front;		//	Stolen from here
+		unsigned int back;		//	Pushed and popped by the owner here
+	} WorkQueue;
+
+	typedef struct
+	{
+		vector<Job *> rootBlocks;
+		size_t nextRoot;
+		Job * freeList;
+		vector<Job *> blocks;
+	} JobPool;
+
+	vector<thread> workers;
+	WorkQueue * queues;	//	One per thread, index 0 is the thread that called Start()
+	JobPool * pools;	//	One per thread, plus a last one shared by threads not owned by this system
+	int threadsCount;
+	mutex externalLock;	//	Guards the shared pool
+
+	atomic<int> queuedJobs;
+	atomic<int> sleepingWorkers;
+	mutex sleepLock;
+	condition_variable wakeUp;
+	atomic<bool> stopping;
+	// Constructors
+public:
+	JobSystem();
+	~JobSystem();
+protected:
+private:
+	// Methods
+public:
+	void Start(int workersCount);
+	void Stop();
+	__inline int GetWorkersCount() const { return (int)workers.size(); }
+	__inline int GetThreadsCount() const { return threadsCount; }
+	Job * Create(void (*function)(Job * job), Job * parent = nullptr);
+	template<typename Work> Job * Create(const Work & work, Job * parent = nullptr);
+	void Run(Job * job);
+	void Wait(const Job * job);
+	template<typename Work> void ParallelFor(int count, int grain, const Work & work);
+	__inline static bool IsFinished(const Job * job) { return job->unfinished.load(memory_order_acquire) <= 0; }
+protected:
+private:
+	int GetThreadIndex() const;
+	Job * AllocateJob(bool root);
+	static void AddRootBlock(JobPool & pool);
+	void ReleaseJob(Job * job);
+	Job * GetJob(int threadIndex);
+	void Execute(Job * job);
+	void Finish(Job * job);
+	void WorkerLoop(int threadIndex);
+	template<typename Work> static void RunPayload(Job * job);
+	template<typename Work> static void DestroyPayload(Job * job);
+	template<typename Work> struct ParallelForRange;
+};
+
+/*
+ * A range of a ParallelFor: it keeps handing the upper half of
+ * its range over to other jobs (so idle threads can steal big
+ * chunks) and runs the last piece itself. Every piece hangs from
+ * the same root, so waiting on the root waits on all of them.
+ */
+template<typename Work>
+struct JobSystem::ParallelForRange
+{
+	JobSystem * system;
+	const Work * work;
+	Job * root;
+	int begin;
+	int end;
+	int grain;
+
+	void operator()() const
+	{
+		int last = end;
+		while(last - begin > grain)
+		{
+			const int middle = begin + (last - begin) / 2;
+			system->Run(system->Create(ParallelForRange{system, work, root, middle, last, grain}, root));
+			last = middle;
+		}
+		(*work)(begin, last);
+	}
+};
+
+/*
+ * Template methods are defined here since they must be visible
+ * to any caller, whatever work they bring along.
+ */
+
+template<typename Work>
+Job * JobSystem::Create(const Work & work, Job * parent)
+{
+	static_assert(sizeof(Work) <= JOB_PAYLOAD_SIZE, "Job payload too big: capture less or capture by pointer");
+	static_assert(alignof(Work) <= alignof(max_align_t), "Job payload over-aligned");
+
+	//	Store the callable in the job itself, no heap allocation
+	Job * job = Create(&RunPayload<Work>, parent);
+	new(job->payload) Work(work);
+	job->destroy = &DestroyPayload<Work>;
+	return job;
+}
+
+template<typename Work>
+void JobSystem::ParallelFor(int count, int grain, const Work & work)
+{
+	/*
+	 * Split [0, count) in ranges of at most grain items and wait
+	 * for all of them. work(begin, end) is called once per range.
+	 */
+	if(count < 1)
+		return;
+	if(grain < 1)
+		grain = 1;
+
+	Job * root = Create([]() { });
+	Run(Create(ParallelForRange<Work>{this, &work, root, 0, count, grain}, root));
+	Run(root);
+	Wait(root);
+}
+
+template<typename Work>
+void JobSystem::RunPayload(Job * job)
+{
+	(*reinterpret_cast<Work *>(job->payload))();
+}
+
+template<typename Work>
+void JobSystem::DestroyPayload(Job * job)
+{
+	reinterpret_cast<Work *>(job->payload)->~Work();
+}
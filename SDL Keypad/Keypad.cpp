@@ -6,6 +6,9 @@
 
 #pragma region Game Includes
 #include "Utilities.h"
+#include "LatencyTracker.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
 #pragma endregion
 
 #pragma region Constant Parameters
@@ -16,6 +19,22 @@
 #define ACTIVE_CHAR_SIZE_RATIO 1.2f
 #define SUBMIT_CHAR_SIZE_RATIO 1.2f
 
+//	Large charsets level of detail
+/*
+ * When slots get closer than this (in character sizes) the
+ * glyphs would overlap: the wheel switches to a fisheye
+ * layout, spreading the slots around the active one at full
+ * size and shrinking (and fading) them away from it.
+ * Glyphs smaller than the minimum size aren't drawn at all,
+ * so the number of drawn glyphs doesn't depend on the
+ * charset size.
+ * Sizes snap to levels LOD_LEVEL_RATIO apart, so the same
+ * few labels get reused while the wheel turns.
+ */
+#define LOD_MIN_SPACING 1.1f
+#define LOD_MIN_GLYPH_SIZE 8
+#define LOD_LEVEL_RATIO 0.75f
+
 //	Trigonometric utilities
 /*
  * Defining our own PI constants, instead of M_PI
@@ -35,9 +54,9 @@
 #define HPI (PI / 2)
 #pragma endregion
 
-Keypad::Keypad(const string & charset, const SDL_Color & mainColor, const SDL_Color & accentColor) :
+Keypad::Keypad(const Charset & charset, const SDL_Color & mainColor, const SDL_Color & accentColor) :
 	charset(charset),
-	charsetLength((int)charset.size()),
+	charsetLength(charset.GetLength()),
 	mainColor(mainColor),
 	accentColor(accentColor),
 	angleStep(PI2 / charsetLength),
@@ -45,10 +64,10 @@ Keypad::Keypad(const string & charset, const SDL_Color & mainColor, const SDL_Co
 	dragging(false)
 { }
 
-string Keypad::ReadBuffer()
+Code Keypad::ReadBuffer()
 {
-	string bufferContent = buffer.str();
-	ClearBuffer();
+	Code bufferContent;
+	bufferContent.swap(buffer);
 	return bufferContent;
 }
 
@@ -94,7 +113,7 @@ void Keypad::BeginInteraction(const SDL_Point & point)
 
 	if(SDL_PointInRect(&point, &submitArea))
 	{	//	Handle submit clicked
-		buffer << PeekActiveCharacter();
+		buffer.push_back(PeekActiveCharacter());
  	}
 	else if(SDL_PointInRect(&point, &area))
 	{	//	Handle drag start
@@ -107,7 +126,7 @@ void Keypad::EndInteraction()
 	dragging = false;
 }
 
-void Keypad::MoveInteraction(const SDL_Point & from, const SDL_Point & to)
+void Keypad::MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp)
 {
 	//	Handle move interaction only when dragging
 	if(!dragging)
@@ -145,10 +164,15 @@ void Keypad::MoveInteraction(const SDL_Point & from, const SDL_Point & to)
 
 	//	Impart the rotation
 	Rotate(currentAngle - prevAngle);
+
+	//	The wheel moved, the next presented frame shows the effect of this input
+	ReportInputEffect(timestamp);
 }
 
 void Keypad::Render(SDL_Renderer * r) const
 {
+	TRACE_SCOPE("Keypad::Render");
+
 	SDL_Rect const * areaPtr = GetViewportArea();
 
 	//	If no viewport area is set, prevent rednering
@@ -168,50 +192,119 @@ void Keypad::Render(SDL_Renderer * r) const
 
 	int characterSize = GetDigitSize(area);
 
-	//	Render all characters in the charset in a circle
-	SDL_Point pointOnWheel;
-	for(int c = 0; c < charsetLength; c++)
-	{
-		float angle = rotation + angleStep * c;
-		GetPointOnWheel(area, angle, pointOnWheel);
-		RenderLabel(
-			r,
-			string{charset[c]},
-			pointOnWheel.x,
-			pointOnWheel.y,
-			mainColor,
-			characterSize
-		);
+	if(radius * angleStep >= characterSize * LOD_MIN_SPACING)
+	{	//	Render all characters in the charset in a circle
+		SDL_Point pointOnWheel;
+		for(int c = 0; c < charsetLength; c++)
+		{
+			float angle = rotation + angleStep * c;
+			GetPointOnWheel(area, angle, pointOnWheel);
+			RenderLabel(
+				r,
+				charset.GetSymbol(c),
+				charset.GetSymbolLength(c),
+				pointOnWheel.x,
+				pointOnWheel.y,
+				mainColor,
+				characterSize
+			);
+		}
 	}
+	else
+		//	Too many characters to fit, render those near the active one
+		RenderWheelDetail(r, area, radius, characterSize);
 
 	// Render active character at the center of the wheel
-	char activeChar = PeekActiveCharacter();
+	const int activeCharacter = GetActiveCharacterIndex();
 	RenderLabel(
 		r,
-		string{activeChar},
+		charset.GetSymbol(activeCharacter),
+		charset.GetSymbolLength(activeCharacter),
 		wheelCenter.x,
 		wheelCenter.y,
 		mainColor,
 		submitArea.h
 	);
 
-	//	Render UX frame for submit button
-	vector<SDL_Point> submitFramePoints;
-	submitFramePoints.push_back({submitArea.x, submitArea.y + submitArea.h / 4});
-	submitFramePoints.push_back({submitArea.x, submitArea.y + submitArea.h});
-	submitFramePoints.push_back({submitArea.x + submitArea.w, submitArea.y + submitArea.h});
-	submitFramePoints.push_back({submitArea.x + submitArea.w, submitArea.y + submitArea.h / 4});
-	submitFramePoints.push_back({submitArea.x + submitArea.w / 2, submitArea.y - submitArea.h / 4});
-	submitFramePoints.push_back({submitArea.x, submitArea.y + submitArea.h / 4});
+	//	Render UX frame for submit button (a fixed outline, on the stack)
+	const SDL_Point submitFramePoints[] = {
+		{submitArea.x, submitArea.y + submitArea.h / 4},
+		{submitArea.x, submitArea.y + submitArea.h},
+		{submitArea.x + submitArea.w, submitArea.y + submitArea.h},
+		{submitArea.x + submitArea.w, submitArea.y + submitArea.h / 4},
+		{submitArea.x + submitArea.w / 2, submitArea.y - submitArea.h / 4},
+		{submitArea.x, submitArea.y + submitArea.h / 4}
+	};
 	SDL_SetRenderDrawColor(r, accentColor.r, accentColor.g, accentColor.b, accentColor.a);
-	SDL_RenderDrawLines(r, submitFramePoints.data(), (int)submitFramePoints.size());
+	StatsRenderDrawLines(r, submitFramePoints, (int)SDL_arraysize(submitFramePoints));
 
 	// Render active character frame on the wheel
 	SDL_SetRenderDrawColor(r, mainColor.r, mainColor.g, mainColor.g, mainColor.a);
-	SDL_RenderDrawRect(r, &activeCharacterArea);
+	StatsRenderDrawRect(r, &activeCharacterArea);
 
 }
 
+void Keypad::RenderWheelDetail(SDL_Renderer * r, const SDL_Rect & area, int radius, int characterSize) const
+{
+	/*
+	 * Slots are placed by their (fractional) offset k from
+	 * the active position, so they slide smoothly while the
+	 * wheel turns. With full size spacing s (in radians), the
+	 * fisheye places a slot at 2 * atan(k * s / 2): spacing is
+	 * s around the active slot, shrinking as
+	 *	scale(k) = 1 / (1 + (k * s / 2)^2)
+	 * away from it, so the whole charset would just fit the
+	 * circle. Glyphs are sized by the same scale, so they
+	 * never overlap, and skipped below the minimum size: only
+	 * a fixed window of slots around the active one is drawn.
+	 */
+	if(characterSize < LOD_MIN_GLYPH_SIZE || radius <= 0)
+		return;
+
+	const float fullStep = characterSize * LOD_MIN_SPACING / radius;
+	const float halfStep = fullStep / 2;
+	const float minScale = (float)LOD_MIN_GLYPH_SIZE / characterSize;
+	const int window = SDL_min((int)(sqrtf(1.0f / minScale - 1.0f) / halfStep), (charsetLength - 1) / 2);
+
+	//	Continuous active position, the nearest slot is at the center of the window
+	const float activePosition = (PI2 - rotation) / angleStep;
+	const int nearest = (int)floorf(activePosition + 0.5f);
+
+	//	Farthest first, so the slots closer to the active one end up on top
+	SDL_Point pointOnWheel;
+	for(int distance = window; distance >= 0; distance--)
+		for(int side = distance > 0 ? -1 : 1; side <= 1; side += 2)
+		{
+			const int slot = nearest + side * distance;
+			const float offset = slot - activePosition;
+			const float spread = offset * halfStep;
+			const float scale = 1.0f / (1.0f + spread * spread);
+			if(scale < minScale)
+				continue;
+
+			//	Snap down to a detail level: sizes and fading come in a few steps
+			const int level = (int)ceilf(logf(scale) / logf(LOD_LEVEL_RATIO) - 0.001f);
+			const float levelScale = powf(LOD_LEVEL_RATIO, (float)level);
+			const int size = (int)(characterSize * levelScale);
+			if(size < LOD_MIN_GLYPH_SIZE)
+				continue;
+			SDL_Color color = mainColor;
+			color.a = (Uint8)(mainColor.a * SDL_min(1.0f, levelScale * 2.0f));
+
+			const int c = ((slot % charsetLength) + charsetLength) % charsetLength;
+			GetPointOnWheel(area, 2.0f * atanf(spread), pointOnWheel);
+			RenderLabel(
+				r,
+				charset.GetSymbol(c),
+				charset.GetSymbolLength(c),
+				pointOnWheel.x,
+				pointOnWheel.y,
+				color,
+				size
+			);
+		}
+}
+
 int Keypad::GetActiveCharacterIndex() const
 {
 	int curChar = (int)((PI2 - rotation + angleStep / 2) / angleStep);
@@ -2,7 +2,6 @@
 
 #pragma region C++ Includes
 #include <string>
-#include <sstream>
 #pragma endregion
 
 #pragma region SDL Includes
@@ -13,6 +12,7 @@
 #pragma region Game Includes
 #include "IRenderable.h"
 #include "IInteractable.h"
+#include "Charset.h"
 #pragma endregion
 
 using namespace std;
@@ -24,6 +24,7 @@ using namespace std;
  * Interanlly, interactions are handled and the input is stored into
  * an internal buffer that can be picked and consumed from any,
  * utilizer, which will need to check and handle it.
+ * The buffer holds charset slots, not text.
  */
 class Keypad : public IRenderable , public IInteractable
 {
@@ -31,27 +32,27 @@ class Keypad : public IRenderable , public IInteractable
 public:
 protected:
 private:
-	const string charset;
+	const Charset charset;
 	const int charsetLength;
 	const SDL_Color mainColor;
 	const SDL_Color accentColor;
 	const float angleStep;
 	float rotation;	//	Never ever set rotation directly, use instead the SetRotation() or the Rotate() methods to handle wrapping
-	ostringstream buffer;
+	Code buffer;
 	bool dragging;
 	// Constructors
 public:
-	Keypad(const string & charset, const SDL_Color & mainColor, const SDL_Color & accentColor);
+	Keypad(const Charset & charset, const SDL_Color & mainColor, const SDL_Color & accentColor);
 protected:
 private:
 	// Methods
 public:
-	__inline const string & GetCharset() const { return charset; }
-	__inline char PeekActiveCharacter() const { return charset[GetActiveCharacterIndex()]; }
-	__inline bool HasPendingCharacter() const { return !buffer.str().empty(); }
-	__inline string PeekBuffer() const { return buffer.str(); }
-	string ReadBuffer();
-	__inline void ClearBuffer() { buffer.str(""); }
+	__inline const Charset & GetCharset() const { return charset; }
+	__inline CharIndex PeekActiveCharacter() const { return (CharIndex)GetActiveCharacterIndex(); }
+	__inline bool HasPendingCharacter() const { return !buffer.empty(); }
+	__inline const Code & PeekBuffer() const { return buffer; }
+	Code ReadBuffer();
+	__inline void ClearBuffer() { buffer.clear(); }
 	void GetPointOnWheel(const SDL_Rect & area, float angle, SDL_Point & point) const;
 	void SetRotation(float angleRad);
 	__inline void Rotate(float angleDeltaRad) { SetRotation(rotation + angleDeltaRad); }
@@ -59,10 +60,11 @@ public:
 	//	IInteractable implementation
 	void BeginInteraction(const SDL_Point & point) override;
 	void EndInteraction() override;
-	void MoveInteraction(const SDL_Point & from, const SDL_Point & to) override;
+	void MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp) override;
 
 	//	IRenderable implementation
 	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override { return IDLE_FOREVER; }	//	Only changes on input
 protected:
 private:
 	int GetActiveCharacterIndex() const;
@@ -71,4 +73,5 @@ private:
 	void GetWheelCenter(const SDL_Rect & area, SDL_Point & center) const;
 	int GetWheelRadius(const SDL_Rect & area) const;
 	void GetParts(const SDL_Rect & area, SDL_Rect * submitArea, SDL_Rect * activeCharacterArea) const;
+	void RenderWheelDetail(SDL_Renderer * r, const SDL_Rect & area, int radius, int characterSize) const;
 };
@@ -0,0 +1,75 @@
+#include "LatencyOverlay.h"
+
+#pragma region C++ Includes
+#include <sstream>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Utilities.h"
+#include "TraceLog.h"
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Color palette
+#define COL_OVERLAY 255, 220, 0, 255
+#define SDL_COL_OVERLAY SDL_Color{COL_OVERLAY}
+
+//	Layout
+#define OVERLAY_TEXT_SIZE 18
+#define OVERLAY_MARGIN 16
+
+//	Refresh rate of the printed values
+#define OVERLAY_REFRESH_TICKS 500
+#pragma endregion
+
+LatencyOverlay::LatencyOverlay() :
+	tracker(nullptr),
+	visible(false),
+	textTicks(0)
+{ }
+
+Uint64 LatencyOverlay::GetIdleTime() const
+{
+	//	Hidden, nothing to refresh (the tracker only changes on input anyway)
+	if(!visible || !tracker)
+		return IDLE_FOREVER;
+
+	return OVERLAY_REFRESH_TICKS;
+}
+
+void LatencyOverlay::Render(SDL_Renderer * r) const
+{
+	TRACE_SCOPE("LatencyOverlay::Render");
+
+	if(!visible || !tracker)
+		return;
+
+	//	Check viewport aera is valid
+	SDL_Rect const * areaPtr = GetViewportArea();
+
+	//	If no viewport area is set, prevent render
+	if(!areaPtr)
+		return;
+
+	const SDL_Rect & area = *areaPtr;
+
+	//	Refresh the text only every now and then
+	const Uint64 now = tracker->GetLastPresentTicks();
+	if(text.IsEmpty() || now >= textTicks + OVERLAY_REFRESH_TICKS)
+	{
+		ostringstream textStream;
+		textStream << "LATENCY P50 " << tracker->GetPercentile(0.50f);
+		textStream << " P95 " << tracker->GetPercentile(0.95f);
+		textStream << " P99 " << tracker->GetPercentile(0.99f);
+		textStream << " MS (" << tracker->GetSampleCount() << ")";
+		text.Set(textStream.str(), SDL_COL_OVERLAY, OVERLAY_TEXT_SIZE);
+		textTicks = now;
+	}
+
+	RenderLabel(
+		r,
+		text,
+		area.x + area.w / 2,
+		area.y + area.h - OVERLAY_MARGIN
+	);
+}
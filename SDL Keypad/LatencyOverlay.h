@@ -0,0 +1,53 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "IRenderable.h"
+#include "LatencyTracker.h"
+#include "TextRun.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Debug overlay printing the input latency percentiles at the
+ * bottom of its viewport area.
+ * The text is refreshed a couple of times per second, so it
+ * stays readable and doesn't create a new label every frame.
+ */
+class LatencyOverlay : public IRenderable
+{
+	// Fields
+public:
+protected:
+private:
+	LatencyTracker const * tracker;
+	bool visible;
+	mutable TextRun text;
+	mutable Uint64 textTicks;
+	// Constructors
+public:
+	LatencyOverlay();
+protected:
+private:
+	// Methods
+public:
+	__inline void SetTracker(const LatencyTracker & latencyTracker) { tracker = &latencyTracker; }
+	__inline void SetVisible(bool show) { visible = show; }
+	__inline bool IsVisible() const { return visible; }
+	__inline void ToggleVisible() { visible = !visible; }
+
+	//	IRenderable implementation
+	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override;
+protected:
+private:
+};
@@ -0,0 +1,97 @@
+#include "LatencyTracker.h"
+
+#pragma region C++ Includes
+#include <iomanip>
+#pragma endregion
+
+//	Inputs are reported to this tracker, when one is set
+static LatencyTracker * latencyTracker = nullptr;
+
+LatencyTracker::LatencyTracker()
+{
+	//	Many motion events can land in a single frame
+	pending.reserve(64);
+	Reset();
+}
+
+void LatencyTracker::ReportInput(Uint32 eventTimestamp)
+{
+	pending.push_back(eventTimestamp);
+}
+
+void LatencyTracker::OnPresent(Uint64 presentTicks)
+{
+	lastPresentTicks = presentTicks;
+
+	for(const Uint32 & timestamp : pending)
+	{
+		//	Event timestamps are the low 32 bits of the same SDL ticks, unsigned math handles the wrap around
+		const Uint32 latency = (Uint32)presentTicks - timestamp;
+
+		histogram[latency < LATENCY_HISTOGRAM_BUCKETS ? latency : LATENCY_HISTOGRAM_BUCKETS - 1]++;
+		samples++;
+		totalLatency += latency;
+		lastLatency = latency;
+		if(latency > worstLatency)
+			worstLatency = latency;
+	}
+
+	pending.clear();
+}
+
+void LatencyTracker::Reset()
+{
+	pending.clear();
+	SDL_memset(histogram, 0, sizeof(histogram));
+	samples = 0;
+	totalLatency = 0;
+	lastLatency = 0;
+	worstLatency = 0;
+	lastPresentTicks = 0;
+}
+
+Uint32 LatencyTracker::GetPercentile(float percentile) const
+{
+	if(samples == 0)
+		return 0;
+
+	//	Walk the histogram up to the bucket holding the requested rank
+	Uint64 rank = (Uint64)(percentile * samples);
+	if(rank < 1)
+		rank = 1;
+
+	Uint64 cumulated = 0;
+	for(Uint32 b = 0; b < LATENCY_HISTOGRAM_BUCKETS; b++)
+	{
+		cumulated += histogram[b];
+		if(cumulated >= rank)
+			return b;
+	}
+
+	return LATENCY_HISTOGRAM_BUCKETS - 1;
+}
+
+void LatencyTracker::PrintReport(ostream & out) const
+{
+	out << "Input-to-photon latency (" << samples << " inputs)" << endl;
+	if(samples == 0)
+		return;
+
+	out << fixed << setprecision(1);
+	out << "	avg " << GetAverage() << " ms" << endl;
+	out << "	p50 " << GetPercentile(0.50f) << " ms" << endl;
+	out << "	p95 " << GetPercentile(0.95f) << " ms" << endl;
+	out << "	p99 " << GetPercentile(0.99f) << " ms" << endl;
+	out << "	max " << worstLatency << " ms" << endl;
+}
+
+void SetLatencyTracker(LatencyTracker * tracker)
+{
+	latencyTracker = tracker;
+}
+
+void ReportInputEffect(Uint32 eventTimestamp)
+{
+	if(latencyTracker)
+		latencyTracker->ReportInput(eventTimestamp);
+}
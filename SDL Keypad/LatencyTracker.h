@@ -0,0 +1,69 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <ostream>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	One bucket per millisecond, the last one collects everything slower
+#define LATENCY_HISTOGRAM_BUCKETS 500
+#pragma endregion
+
+/*
+ * Measures input-to-photon latency: the time between an input
+ * event (as stamped by SDL) and the present of the first frame
+ * showing its effect.
+ * Game elements report the timestamp of the inputs they applied
+ * and the main loop tells when the frame is presented, right
+ * after SDL_RenderPresent. Latencies are collected in a
+ * millisecond histogram (SDL event timestamps have millisecond
+ * resolution anyway) to get percentiles without storing samples.
+ */
+class LatencyTracker
+{
+	// Fields
+public:
+protected:
+private:
+	vector<Uint32> pending;		//	Inputs applied this frame, waiting for the present
+	Uint32 histogram[LATENCY_HISTOGRAM_BUCKETS];
+	Uint64 samples;
+	Uint64 totalLatency;
+	Uint32 lastLatency;
+	Uint32 worstLatency;
+	Uint64 lastPresentTicks;
+	// Constructors
+public:
+	LatencyTracker();
+protected:
+private:
+	// Methods
+public:
+	void ReportInput(Uint32 eventTimestamp);
+	void OnPresent(Uint64 presentTicks);
+	void Reset();
+	Uint32 GetPercentile(float percentile) const;
+	__inline Uint64 GetSampleCount() const { return samples; }
+	__inline double GetAverage() const { return samples > 0 ? (double)totalLatency / samples : 0.0; }
+	__inline Uint32 GetLast() const { return lastLatency; }
+	__inline Uint32 GetWorst() const { return worstLatency; }
+	__inline Uint64 GetLastPresentTicks() const { return lastPresentTicks; }
+	void PrintReport(ostream & out) const;
+protected:
+private:
+};
+
+/*
+ * Game elements don't know the engine, they report their
+ * inputs to the tracker registered here, if any.
+ */
+void SetLatencyTracker(LatencyTracker * tracker);
+void ReportInputEffect(Uint32 eventTimestamp);
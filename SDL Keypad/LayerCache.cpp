@@ -0,0 +1,136 @@
+#include "LayerCache.h"
+
+#pragma region C++ Includes
+#include <iomanip>
+#pragma endregion
+
+#pragma region Game Includes
+#include "RenderStats.h"
+#pragma endregion
+
+LayerCache * LayerCache::first = nullptr;
+Uint64 LayerCache::totalHits = 0;
+Uint64 LayerCache::totalRebuilds = 0;
+
+LayerCache::LayerCache() :
+	texture(nullptr),
+	w(0),
+	h(0),
+	valid(false),
+	hits(0),
+	rebuilds(0),
+	prev(nullptr),
+	next(first)
+{
+	if(first)
+		first->prev = this;
+	first = this;
+}
+
+LayerCache::~LayerCache()
+{
+	Release();
+
+	if(prev)
+		prev->next = next;
+	else
+		first = next;
+	if(next)
+		next->prev = prev;
+}
+
+void LayerCache::Draw(SDL_Renderer * r, const SDL_Rect & area, const LayerBuilder & build)
+{
+	//	No render targets (or no room for one): draw straight to the screen
+	if(!Prepare(r, area))
+	{
+		build(r, area);
+		return;
+	}
+
+	if(valid)
+	{
+		hits++;
+		totalHits++;
+	}
+	else
+	{
+		rebuilds++;
+		totalRebuilds++;
+
+		//	Draw the layer on a transparent texture, keeping the renderer state as it was
+		SDL_Texture * previousTarget = SDL_GetRenderTarget(r);
+		Uint8 red, green, blue, alpha;
+		SDL_GetRenderDrawColor(r, &red, &green, &blue, &alpha);
+
+		SDL_SetRenderTarget(r, texture);
+		SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+		StatsRenderClear(r);
+		valid = build(r, SDL_Rect{0, 0, w, h});
+
+		SDL_SetRenderTarget(r, previousTarget);
+		SDL_SetRenderDrawColor(r, red, green, blue, alpha);
+	}
+
+	StatsRenderCopy(r, texture, nullptr, &area);
+}
+
+void LayerCache::Release()
+{
+	if(texture)
+		SDL_DestroyTexture(texture);
+	texture = nullptr;
+	w = 0;
+	h = 0;
+	valid = false;
+}
+
+void LayerCache::InvalidateAll()
+{
+	//	Render targets content is lost on device resets
+	for(LayerCache * cache = first; cache; cache = cache->next)
+		cache->Invalidate();
+}
+
+void LayerCache::ReleaseAll()
+{
+	//	Textures die with their renderer, this must run before it gets destroyed
+	for(LayerCache * cache = first; cache; cache = cache->next)
+		cache->Release();
+}
+
+void LayerCache::PrintReport(ostream & out)
+{
+	const Uint64 draws = totalHits + totalRebuilds;
+	out << "Layer caches: " << totalHits << " hits, " << totalRebuilds << " rebuilds";
+	if(draws > 0)
+		out << " (" << fixed << setprecision(1) << 100.0 * totalHits / draws << "% hit rate)";
+	out << endl;
+}
+
+bool LayerCache::Prepare(SDL_Renderer * r, const SDL_Rect & area)
+{
+	if(area.w <= 0 || area.h <= 0 || !SDL_RenderTargetSupported(r))
+		return false;
+
+	//	The texture matches the area size, a new size means a new texture
+	if(texture && w == area.w && h == area.h)
+		return true;
+
+	Release();
+	texture = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, area.w, area.h);
+	if(!texture)
+		return false;
+	w = area.w;
+	h = area.h;
+
+	//	Premultiplied alpha compositing, plain blending where custom modes aren't supported
+	const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+	);
+	if(SDL_SetTextureBlendMode(texture, premultiplied) != 0)
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+	return true;
+}
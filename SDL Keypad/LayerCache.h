@@ -0,0 +1,83 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <functional>
+#include <ostream>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Draws a layer: the area to draw into is given, in the
+ * coordinates of the current render target. Returns false
+ * when something wasn't final yet (e.g. a label still
+ * being rasterized), so the layer gets built again.
+ */
+typedef function<bool(SDL_Renderer * r, const SDL_Rect & area)> LayerBuilder;
+
+/*
+ * Caches what an element draws into a render target texture,
+ * so following frames only copy that texture until the element
+ * invalidates it (or its area changes size).
+ * Elements keep a cache as a mutable field, since rendering
+ * is const, and call Invalidate() whenever what they show
+ * changes.
+ * The texture holds premultiplied alpha (that's what blending
+ * into a transparent target produces), so it's composited with
+ * a matching blend mode and layers with translucent edges look
+ * the same as when drawn directly.
+ * When the renderer doesn't support render targets, layers
+ * are simply drawn every frame.
+ * All caches are linked together, so the engine can drop
+ * their textures when the renderer loses them or before the
+ * renderer gets destroyed.
+ */
+class LayerCache
+{
+	// Fields
+public:
+protected:
+private:
+	SDL_Texture * texture;
+	int w;
+	int h;
+	bool valid;
+	Uint64 hits;
+	Uint64 rebuilds;
+
+	//	All caches, to release them together
+	LayerCache * prev;
+	LayerCache * next;
+	static LayerCache * first;
+	static Uint64 totalHits;
+	static Uint64 totalRebuilds;
+	// Constructors
+public:
+	LayerCache();
+	~LayerCache();
+	LayerCache(const LayerCache &) = delete;
+	LayerCache & operator=(const LayerCache &) = delete;
+protected:
+private:
+	// Methods
+public:
+	void Draw(SDL_Renderer * r, const SDL_Rect & area, const LayerBuilder & build);
+	__inline void Invalidate() { valid = false; }
+	void Release();
+	__inline Uint64 GetHits() const { return hits; }
+	__inline Uint64 GetRebuilds() const { return rebuilds; }
+
+	static void InvalidateAll();
+	static void ReleaseAll();
+	__inline static Uint64 GetTotalHits() { return totalHits; }
+	__inline static Uint64 GetTotalRebuilds() { return totalRebuilds; }
+	static void PrintReport(ostream & out);
+protected:
+private:
+	bool Prepare(SDL_Renderer * r, const SDL_Rect & area);
+};
@@ -1,5 +1,9 @@
 #include "LockpickingGame.h"
 
+#pragma region Game Includes
+#include "TraceLog.h"
+#pragma endregion
+
 #pragma region Constant Parameters
 //	Color palette
 #define COL_TEXT 0, 230, 255, 255
@@ -47,6 +51,7 @@ LockpickingGame::LockpickingGame() :
 		SDL_COL_CODE_CLOSE_ENOUGH
 	),
 	codeDisplay(
+		gameState.GetCharset(),
 		gameState.GetCodeLength(),
 		DIGITS_SPACING,
 		SDL_COL_TEXT,
@@ -69,7 +74,12 @@ LockpickingGame::LockpickingGame() :
 	gameStateArea{0, 0, 100, 100},
 	codeDisplayArea{0, 0, 100, 100},
 	keypadArea{0, 0, 100, 100},
-	gameOverArea{0, 0, 100, 100}
+	gameOverArea{0, 0, 100, 100},
+	timers(nullptr),
+	stageClearTimer(OnStageClearRoutineEnd, this),
+	telemetry(nullptr),
+	session(0),
+	gameOverLogged(false)
 {
 	//	Assign viewport areas to all relevant game elements (stored as pointers so they automatically update when modified anywhere else)
 	gameState.SetViewportArea(gameStateArea);
@@ -78,6 +88,12 @@ LockpickingGame::LockpickingGame() :
 	gameOverScreen.SetViewportArea(gameOverArea);
 }
 
+void LockpickingGame::SetClock(const FrameClock & frameClock)
+{
+	//	Share the frame clock with all timed game elements
+	gameState.SetClock(frameClock);
+}
+
 void LockpickingGame::BeginInteraction(const SDL_Point & point)
 {
 	//	Prevent interaction when not allowed
@@ -113,7 +129,7 @@ void LockpickingGame::EndInteraction()
 	}
 }
 
-void LockpickingGame::MoveInteraction(const SDL_Point & from, const SDL_Point & to)
+void LockpickingGame::MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp)
 {
 	//	Prevent interaction when not allowed
 	if(!IsInteractionAllowed())
@@ -121,17 +137,19 @@ void LockpickingGame::MoveInteraction(const SDL_Point & from, const SDL_Point &
 
 	if(gameState.IsGameOn())
 	{	//	Feed interactions to game elements
-		codeDisplay.MoveInteraction(from, to);
-		keypad.MoveInteraction(from, to);
+		codeDisplay.MoveInteraction(from, to, timestamp);
+		keypad.MoveInteraction(from, to, timestamp);
 	}
 	else
 	{	//	Feed interaction to game over screen
-		gameOverScreen.MoveInteraction(from, to);
+		gameOverScreen.MoveInteraction(from, to, timestamp);
 	}
 }
 
 void LockpickingGame::Render(SDL_Renderer * r) const
 {
+	TRACE_SCOPE("LockpickingGame::Render");
+
 	//	Check viewport aera is valid
 	SDL_Rect const * areaPtr = GetViewportArea();
 
@@ -143,7 +161,7 @@ void LockpickingGame::Render(SDL_Renderer * r) const
 
 	//	Determine what to render, based on the game state
 	if(
-		stageClearRoutine ||	//	If a stage was just cleared, wait for the end of the routine to display game over screen
+		IsStageClearRoutineRunning() ||	//	If a stage was just cleared, wait for the end of the routine to display game over screen
 		gameState.IsGameOn()
 	)
 	{	//	Standard gameplay, just feed render in the correct order
@@ -157,18 +175,17 @@ void LockpickingGame::Render(SDL_Renderer * r) const
 	}
 }
 
-void LockpickingGame::OnFrameInitialization()
+Uint64 LockpickingGame::GetIdleTime() const
 {
-	//	Handle stage clear routine
-	if(
-		stageClearRoutine &&
-		SDL_GetTicks64() > stageClearRoutineStart + STAGE_CLEAR_ROUTINE_DURATION
-	)
-	{
-		stageClearRoutine = false;
-		EndStageClearRoutine();
-	}
+	//	Same choice as Render: the idle time of what's on screen
+	if(IsStageClearRoutineRunning() || gameState.IsGameOn())
+		return SDL_min(SDL_min(keypad.GetIdleTime(), codeDisplay.GetIdleTime()), gameState.GetIdleTime());
+
+	return gameOverScreen.GetIdleTime();
+}
 
+void LockpickingGame::OnFrameInitialization()
+{
 	//	Check viewport aera is valid
 	SDL_Rect const * areaPtr = GetViewportArea();
 
@@ -193,30 +210,35 @@ void LockpickingGame::OnPreRender()
 		if(keypad.HasPendingCharacter())
 		{
 			//	Build the new code input
-			ostringstream newCodeInputStream;
+			Code newCodeInput;
 			if(!codeDisplay.IsFull())
-				newCodeInputStream << codeDisplay.GetDigits();	//	If full, start over
-			newCodeInputStream << keypad.ReadBuffer();
-			string newCodeInput = newCodeInputStream.str().substr(0, gameState.GetCodeLength());	//	Make sure to not overflow
+				newCodeInput = codeDisplay.GetDigits();	//	If full, start over
+			const Code typed = keypad.ReadBuffer();
+			newCodeInput.insert(newCodeInput.end(), typed.begin(), typed.end());
+			if(newCodeInput.size() > gameState.GetCodeLength())
+				newCodeInput.resize(gameState.GetCodeLength());	//	Make sure to not overflow
 
 			//	Feed the code input to the display
 			if(!gameState.IsFullCode(newCodeInput))
+			{
 				//	Set only digits, render with default color
 				codeDisplay.SetDigits(newCodeInput);
+				codeErrors.clear();
+			}
 			else
 			{
 				//	Evaluate digit-by-digit error
-				vector<Uint8> newCodeErrors = gameState.EvaluateCodeError(newCodeInput);
+				codeErrors = gameState.EvaluateCodeError(newCodeInput);
 
 				//	Prepare colors for all digits to display error hints
 				vector<SDL_Color> newCodeColors;
-				for(const Uint8 & digitError : newCodeErrors)
-					if(digitError < 1)	//	No error, correct digit
-						newCodeColors.push_back(SDL_COL_CODE_CORRECT);
-					else if(digitError < 2)	//	Nearby digit, wrong but close
-						newCodeColors.push_back(SDL_COL_CODE_CLOSE_ENOUGH);
-					else	//	The digit wasn't even close
-						newCodeColors.push_back(SDL_COL_CODE_WRONG);
+				for(const Uint8 & digitError : codeErrors)
+					switch(GetDigitHint(digitError))
+					{
+						case SHARED_HINT_CORRECT: newCodeColors.push_back(SDL_COL_CODE_CORRECT); break;
+						case SHARED_HINT_CLOSE: newCodeColors.push_back(SDL_COL_CODE_CLOSE_ENOUGH); break;
+						default: newCodeColors.push_back(SDL_COL_CODE_WRONG); break;
+					}
 
 				//	Set both digits and colors
 				codeDisplay.SetDigits(newCodeInput, &newCodeColors);
@@ -224,8 +246,13 @@ void LockpickingGame::OnPreRender()
 
 			//	Finally, submit the code to the game state
 			const bool stageCompleted = gameState.SubmitCode(codeDisplay.GetDigits());
+			if(gameState.IsFullCode(codeDisplay.GetDigits()))
+				LogEvent(TelemetryEvent::Submission, stageCompleted ? TELEMETRY_FLAG_MATCH : 0);
 			if(stageCompleted)
+			{
+				LogEvent(TelemetryEvent::StageCleared);
 				BeginStageClearRoutine();
+			}
 		}
 	}
 	else
@@ -233,38 +260,124 @@ void LockpickingGame::OnPreRender()
 		//	Handle restart requested
 		if(gameOverScreen.ConsumeSkipRequested())
 		{
+			LogEvent(TelemetryEvent::Restart);
 			gameOverScreen.SetSuccess(false);
 			codeDisplay.Clear();
 			keypad.ClearBuffer();
 			gameState.Restart();
+			LogEvent(TelemetryEvent::GameStart);
+			gameOverLogged = false;
 		}
 	}
+
+	//	Games end on the last submission or when time runs out, with no input at all
+	if(!gameOverLogged && gameState.IsGameOver())
+	{
+		LogEvent(gameState.AreStagesCleared() ? TelemetryEvent::GameWon : TelemetryEvent::GameLost);
+		gameOverLogged = true;
+	}
 }
 
 bool LockpickingGame::IsInteractionAllowed() const
 {
-	return IInteractable::IsInteractionAllowed() && !stageClearRoutine /* ...more locking conditions here... */;
+	return IInteractable::IsInteractionAllowed() && !IsStageClearRoutineRunning() /* ...more locking conditions here... */;
 }
 
 /*
- * The stage completion routine is a ugly way to add a timed
- * sequence that aims at leaving the success condition visible
- * before passing to next stage or to game over screen.
- * It's ugly because it's hardcoded: a better version could
- * rely on a sort of "break" system that could request a hold
- * for a parameterized time and accept a callback for when the
- * timer comes to an end.
- * Simply not worth the hassle in such a small project.
+ * The stage completion routine leaves the success condition
+ * visible for a while before passing to next stage or to game
+ * over screen: a timer on the engine's timer wheel holds the
+ * game until it fires.
  */
 
 void LockpickingGame::BeginStageClearRoutine()
 {
-	stageClearRoutineStart = SDL_GetTicks64();
-	stageClearRoutine = true;
 	gameOverScreen.SetSuccess(gameState.AreStagesCleared());
+
+	//	Without a timer wheel there's no hold, move on right away
+	if(!timers)
+	{
+		EndStageClearRoutine();
+		return;
+	}
+
+	timers->ScheduleIn(stageClearTimer, STAGE_CLEAR_ROUTINE_DURATION);
 }
 
 void LockpickingGame::EndStageClearRoutine()
 {
 	codeDisplay.Clear();
 }
+
+void LockpickingGame::OnStageClearRoutineEnd(void * game)
+{
+	static_cast<LockpickingGame *>(game)->EndStageClearRoutine();
+}
+
+void LockpickingGame::SetTelemetryLog(TelemetryLog & log)
+{
+	//	The game in progress is the first session recorded
+	telemetry = &log;
+	LogEvent(TelemetryEvent::GameStart);
+}
+
+void LockpickingGame::LogEvent(const TelemetryEvent type, const Uint8 flags)
+{
+	if(!telemetry)
+		return;
+
+	if(type == TelemetryEvent::GameStart)
+		session++;
+
+	TelemetryRecord record;
+	SDL_zero(record);
+	const GameRules & rules = gameState.GetRules();
+	record.session = session;
+	record.timeLeft = (Uint32)(gameState.GetTimeLeft() * rules.GetSolveTime());
+	record.type = (Uint8)type;
+	record.stagesLeft = rules.GetStagesLeft();
+	record.codeLength = (Uint8)SDL_min((int)rules.GetCodeLength(), TELEMETRY_MAX_CODE);
+	record.flags = flags;
+
+	//	Submissions carry the code as input and its errors
+	if(type == TelemetryEvent::Submission)
+	{
+		const Code & digits = codeDisplay.GetDigits();
+		for(int d = 0; d < record.codeLength && d < (int)digits.size() && d < (int)codeErrors.size(); d++)
+		{
+			record.input[d] = digits[d];
+			record.digitErrors[d] = codeErrors[d];
+		}
+	}
+
+	telemetry->Append(record);
+}
+
+void LockpickingGame::GetSharedState(SharedGameState & state) const
+{
+	SDL_zero(state);
+
+	const GameRules & rules = gameState.GetRules();
+	state.solveTime = rules.GetSolveTime();
+	state.timeLeft = (Uint32)(gameState.GetTimeLeft() * state.solveTime);
+	state.stages = rules.GetStages();
+	state.stagesLeft = rules.GetStagesLeft();
+	state.codeLength = (Uint8)SDL_min((int)rules.GetCodeLength(), SHARED_STATE_MAX_CODE);
+	if(gameState.AreStagesCleared())
+		state.status = SHARED_STATUS_WON;
+	else if(gameState.IsTimeUp())
+		state.status = SHARED_STATUS_LOST;
+	else
+		state.status = SHARED_STATUS_PLAYING;
+
+	//	The input as displayed, with its hints once complete
+	const Code & digits = codeDisplay.GetDigits();
+	const Charset & charset = gameState.GetCharset();
+	state.inputLength = (Uint8)SDL_min((int)digits.size(), (int)state.codeLength);
+	const bool hinted = codeDisplay.IsFull() && codeErrors.size() == digits.size();
+	for(int d = 0; d < state.inputLength; d++)
+	{
+		state.input[d] = charset.GetCodePoint(digits[d]);
+		state.hints[d] = hinted ? GetDigitHint(codeErrors[d]) : (Uint8)SHARED_HINT_NONE;
+	}
+}
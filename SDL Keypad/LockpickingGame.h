@@ -9,6 +9,10 @@
 #include "CodeDisplay.h"
 #include "Keypad.h"
 #include "GameOverScreen.h"
+#include "FrameClock.h"
+#include "TimerWheel.h"
+#include "SharedState.h"
+#include "TelemetryLog.h"
 #pragma endregion
 
 #pragma region SDL Includes
@@ -46,9 +50,17 @@ private:
 	SDL_Rect keypadArea;
 	SDL_Rect gameOverArea;
 
+	//	Errors of the complete code on display, if any
+	vector<Uint8> codeErrors;
+
 	//	Timing
-	bool stageClearRoutine = false;
-	Uint64 stageClearRoutineStart = 0;
+	TimerWheel * timers;
+	Timer stageClearTimer;
+
+	//	Analytics
+	TelemetryLog * telemetry;
+	Uint32 session;
+	bool gameOverLogged;
 	// Constructors
 public:
 	LockpickingGame();
@@ -56,22 +68,32 @@ protected:
 private:
 	// Methods
 public:
+	void SetClock(const FrameClock & frameClock);
+	__inline void SetTimerWheel(TimerWheel & timerWheel) { timers = &timerWheel; }
+	void SetTelemetryLog(TelemetryLog & log);
+	void GetSharedState(SharedGameState & state) const;
+
 	//	IInteractable implementation
 	void BeginInteraction(const SDL_Point & point) override;
 	void EndInteraction() override;
-	void MoveInteraction(const SDL_Point & from, const SDL_Point & to) override;
+	void MoveInteraction(const SDL_Point & from, const SDL_Point & to, Uint32 timestamp) override;
 
 	//	IRenderable implementation
 	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override;
 
 	//	ILifecycle implementation
+	Uint32 GetLifecyclePhases() const override { return PHASE_BIT(FramePhase::FrameInitialization) | PHASE_BIT(FramePhase::PreRender); }
 	void OnFrameInitialization() override;
 	void OnPreRender() override;
 protected:
 	//	IInteractable implementation
 	bool IsInteractionAllowed() const override;
 private:
+	__inline bool IsStageClearRoutineRunning() const { return stageClearTimer.IsScheduled(); }
 	void BeginStageClearRoutine();
 	void EndStageClearRoutine();
+	static void OnStageClearRoutineEnd(void * game);
+	void LogEvent(const TelemetryEvent type, const Uint8 flags = 0);
 };
 
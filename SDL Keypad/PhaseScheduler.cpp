@@ -0,0 +1,134 @@
+#include "PhaseScheduler.h"
+
+#pragma region Game Includes
+#include "TraceLog.h"
+#pragma endregion
+
+PhaseScheduler::PhaseScheduler() :
+	dirty(false),
+	jobs(nullptr)
+{ }
+
+void PhaseScheduler::AddSystem(
+	FramePhase phase, const char * name, const function<void()> & run,
+	Uint32 reads, Uint32 writes, bool mainThreadOnly
+)
+{
+	phases[(int)phase].push_back({name, run, reads, writes, mainThreadOnly, 0});
+	dirty = true;
+}
+
+void PhaseScheduler::AddLifecycle(ILifecycle * receiver, const char * name, Uint32 reads, Uint32 writes)
+{
+	/*
+	 * Register one system per implemented hook. Lifecycle receivers
+	 * are game elements that may touch SDL, so they stay on the
+	 * main thread.
+	 */
+	const Uint32 implemented = receiver->GetLifecyclePhases();
+
+	if(implemented & PHASE_BIT(FramePhase::FrameStart))
+		AddSystem(FramePhase::FrameStart, name, [receiver]() { receiver->OnFrameStart(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::FrameInitialization))
+		AddSystem(FramePhase::FrameInitialization, name, [receiver]() { receiver->OnFrameInitialization(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::PreEventsLoop))
+		AddSystem(FramePhase::PreEventsLoop, name, [receiver]() { receiver->OnPreEventsLoop(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::PreRender))
+		AddSystem(FramePhase::PreRender, name, [receiver]() { receiver->OnPreRender(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::PostRenderClear))
+		AddSystem(FramePhase::PostRenderClear, name, [receiver]() { receiver->OnPostRenderClear(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::PreRenderPresent))
+		AddSystem(FramePhase::PreRenderPresent, name, [receiver]() { receiver->OnPreRenderPresent(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::PostRenderPresent))
+		AddSystem(FramePhase::PostRenderPresent, name, [receiver]() { receiver->OnPostRenderPresent(); }, reads, writes);
+	if(implemented & PHASE_BIT(FramePhase::FrameEnd))
+		AddSystem(FramePhase::FrameEnd, name, [receiver]() { receiver->OnFrameEnd(); }, reads, writes);
+}
+
+void PhaseScheduler::RunPhase(FramePhase phase)
+{
+	if(dirty)
+		BuildBatches();
+
+	for(const vector<System *> & batch : batches[(int)phase])
+	{
+		//	Count systems that may leave the main thread
+		int parallelCount = 0;
+		for(System * const & system : batch)
+			if(!system->mainThreadOnly)
+				parallelCount++;
+
+		if(!jobs || jobs->GetWorkersCount() < 1 || parallelCount < 2)
+		{	//	Nothing to gain from the workers, run in registration order
+			for(System * const & system : batch)
+				RunSystem(system);
+		}
+		else
+			RunParallel(batch);
+	}
+}
+
+bool PhaseScheduler::Conflict(const System & a, const System & b)
+{
+	return
+		(a.writes & (b.reads | b.writes)) ||
+		(b.writes & a.reads);
+}
+
+void PhaseScheduler::BuildBatches()
+{
+	/*
+	 * Each system goes in the batch right after the latest
+	 * batch holding an earlier system it conflicts with. This
+	 * keeps the registration order for dependent systems and
+	 * packs independent ones together.
+	 * Systems are only added before the main loop starts, so
+	 * this runs once.
+	 */
+	for(int p = 0; p < (int)FramePhase::Count; p++)
+	{
+		vector<System> & systems = phases[p];
+		vector<vector<System *>> & phaseBatches = batches[p];
+		phaseBatches.clear();
+
+		for(size_t s = 0; s < systems.size(); s++)
+		{
+			int batch = 0;
+			for(size_t prev = 0; prev < s; prev++)
+				if(Conflict(systems[s], systems[prev]) && systems[prev].batch + 1 > batch)
+					batch = systems[prev].batch + 1;
+
+			systems[s].batch = batch;
+			if((int)phaseBatches.size() <= batch)
+				phaseBatches.resize(batch + 1);
+			phaseBatches[batch].push_back(&systems[s]);
+		}
+	}
+
+	dirty = false;
+}
+
+void PhaseScheduler::RunParallel(const vector<System *> & batch)
+{
+	//	Hand the systems that may leave the main thread to the job system
+	Job * root = jobs->Create([]() { });
+	for(System * const & system : batch)
+		if(!system->mainThreadOnly)
+			jobs->Run(jobs->Create([system]() { RunSystem(system); }, root));
+	jobs->Run(root);
+
+	//	Main-thread systems run here, meanwhile workers pick the others
+	for(System * const & system : batch)
+		if(system->mainThreadOnly)
+			RunSystem(system);
+
+	//	Then help with whatever is left until the whole batch is done
+	jobs->Wait(root);
+}
+
+void PhaseScheduler::RunSystem(System * system)
+{
+	//	Systems show up in traces by their registration name
+	TraceZone zone(system->name);
+	system->run();
+}
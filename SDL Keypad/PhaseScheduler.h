@@ -0,0 +1,89 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <functional>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "ILifecycle.h"
+#include "JobSystem.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Shared resources systems can declare to read or write.
+ * Two systems conflict when one writes something the other
+ * reads or writes: conflicting systems keep their registration
+ * order, the others may run concurrently.
+ * Games can define their own resources from RESOURCE_USER on.
+ */
+enum FrameResource : Uint32
+{
+	RESOURCE_NONE = 0,
+	RESOURCE_RENDERER = 1 << 0,
+	RESOURCE_WINDOW = 1 << 1,
+	RESOURCE_CLOCK = 1 << 2,
+	RESOURCE_INPUT = 1 << 3,
+	RESOURCE_LAYOUT = 1 << 4,
+	RESOURCE_GAME = 1 << 5,
+	RESOURCE_USER = 1 << 8
+};
+
+/*
+ * Runs the lifecycle of the main loop as a graph of phases.
+ * Instead of broadcasting every hook to every receiver, systems
+ * register a callback only for the phases they implement, along
+ * with the resources they access. Each phase is split into
+ * batches of systems that don't conflict with each other: batches
+ * run in order, systems within a batch can run in parallel as
+ * jobs (when a job system with workers is available and the
+ * systems don't need the main thread).
+ */
+class PhaseScheduler
+{
+	// Fields
+public:
+protected:
+private:
+	typedef struct
+	{
+		const char * name;
+		function<void()> run;
+		Uint32 reads;
+		Uint32 writes;
+		bool mainThreadOnly;
+		int batch;
+	} System;
+
+	vector<System> phases[(int)FramePhase::Count];
+	vector<vector<System *>> batches[(int)FramePhase::Count];
+	bool dirty;
+	JobSystem * jobs;
+	// Constructors
+public:
+	PhaseScheduler();
+protected:
+private:
+	// Methods
+public:
+	__inline void SetJobSystem(JobSystem * jobSystem) { jobs = jobSystem; }
+	void AddSystem(
+		FramePhase phase, const char * name, const function<void()> & run,
+		Uint32 reads, Uint32 writes, bool mainThreadOnly = true
+	);
+	void AddLifecycle(ILifecycle * receiver, const char * name, Uint32 reads, Uint32 writes);
+	void RunPhase(FramePhase phase);
+protected:
+private:
+	static bool Conflict(const System & a, const System & b);
+	void BuildBatches();
+	void RunParallel(const vector<System *> & batch);
+	static void RunSystem(System * system);
+};
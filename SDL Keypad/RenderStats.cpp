@@ -0,0 +1,84 @@
+#include "RenderStats.h"
+
+#pragma region C++ Includes
+#include <cstdlib>
+#include <new>
+#pragma endregion
+
+atomic<bool> RenderStats::enabled(false);
+atomic<Uint32> RenderStats::counters[STATS_COUNTERS];
+Uint32 RenderStats::lastFrame[STATS_COUNTERS] = {};
+float RenderStats::frameTimes[STATS_HISTORY_FRAMES] = {};
+float RenderStats::intervals[STATS_HISTORY_FRAMES] = {};
+int RenderStats::historyIndex = 0;
+
+void RenderStats::SetEnabled(bool enable)
+{
+	//	Start from a clean frame, counts from before make no sense
+	for(int c = 0; c < STATS_COUNTERS; c++)
+	{
+		counters[c].store(0, memory_order_relaxed);
+		lastFrame[c] = 0;
+	}
+	for(int f = 0; f < STATS_HISTORY_FRAMES; f++)
+	{
+		frameTimes[f] = 0.0f;
+		intervals[f] = 0.0f;
+	}
+	enabled.store(enable, memory_order_relaxed);
+}
+
+void RenderStats::EndFrame(double frameTime, double interval)
+{
+	if(!IsEnabled())
+		return;
+
+	for(int c = 0; c < STATS_COUNTERS; c++)
+		lastFrame[c] = counters[c].exchange(0, memory_order_relaxed);
+
+	historyIndex = (historyIndex + 1) % STATS_HISTORY_FRAMES;
+	frameTimes[historyIndex] = (float)(frameTime * 1000.0);
+	intervals[historyIndex] = (float)(interval * 1000.0);
+}
+
+float RenderStats::GetFrameTime(int age)
+{
+	//	Age 0 is the last frame
+	return frameTimes[(historyIndex - age % STATS_HISTORY_FRAMES + STATS_HISTORY_FRAMES) % STATS_HISTORY_FRAMES];
+}
+
+float RenderStats::GetFps()
+{
+	//	Over the whole history, frames the loop slept before have no interval
+	float sum = 0.0f;
+	int count = 0;
+	for(int f = 0; f < STATS_HISTORY_FRAMES; f++)
+		if(intervals[f] > 0.0f)
+		{
+			sum += intervals[f];
+			count++;
+		}
+
+	return sum > 0.0f ? count * 1000.0f / sum : 0.0f;
+}
+
+#pragma region Allocation Hooks
+/*
+ * Replacing the global operator new and delete is how every
+ * C++ allocation gets counted, the array and nothrow forms
+ * end up here too.
+ */
+void * operator new(size_t size)
+{
+	RenderStats::Count(RenderStats::STATS_ALLOCATIONS);
+	void * memory = malloc(size > 0 ? size : 1);
+	if(!memory)
+		throw bad_alloc();
+	return memory;
+}
+
+void operator delete(void * memory) noexcept
+{
+	free(memory);
+}
+#pragma endregion
@@ -0,0 +1,115 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <atomic>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+
+//	SDL Modules
+#include <SDL_ttf.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Frames kept for the frame time graph
+#define STATS_HISTORY_FRAMES 120
+#pragma endregion
+
+/*
+ * Per-frame counters of the expensive calls: draw calls, texture
+ * uploads, font opens and heap allocations (through operator new,
+ * on any thread; SDL and FreeType allocations aren't included).
+ * Game code goes through the thin Stats* wrappers below instead
+ * of calling SDL directly. Counting only happens while stats are
+ * enabled: otherwise a wrapper costs a well predicted branch on
+ * top of the call it wraps.
+ * The main loop closes each frame, saving the counts along with
+ * the frame time in a short history for the stats overlay.
+ */
+class RenderStats
+{
+	// Fields
+public:
+	enum Counter : int
+	{
+		STATS_DRAW_CALLS,
+		STATS_TEXTURE_UPLOADS,
+		STATS_FONT_OPENS,
+		STATS_ALLOCATIONS,
+		STATS_COUNTERS
+	};
+protected:
+private:
+	static atomic<bool> enabled;					//	Read by allocations on any thread
+	static atomic<Uint32> counters[STATS_COUNTERS];	//	Current frame, fonts and allocations come from workers too
+	static Uint32 lastFrame[STATS_COUNTERS];
+	static float frameTimes[STATS_HISTORY_FRAMES];	//	Milliseconds, circular
+	static float intervals[STATS_HISTORY_FRAMES];	//	Milliseconds between presents, circular
+	static int historyIndex;
+	// Constructors
+public:
+protected:
+private:
+	// Methods
+public:
+	static void SetEnabled(bool enable);
+	__inline static bool IsEnabled() { return enabled.load(memory_order_relaxed); }
+	__inline static void Count(Counter counter)
+	{
+		if(enabled.load(memory_order_relaxed))
+			counters[counter].fetch_add(1, memory_order_relaxed);
+	}
+	static void EndFrame(double frameTime, double interval);
+	__inline static Uint32 GetLastFrame(Counter counter) { return lastFrame[counter]; }
+	static float GetFrameTime(int age);
+	static float GetFps();
+protected:
+private:
+};
+
+#pragma region Counting Wrappers
+__inline int StatsRenderClear(SDL_Renderer * r)
+{
+	RenderStats::Count(RenderStats::STATS_DRAW_CALLS);
+	return SDL_RenderClear(r);
+}
+__inline int StatsRenderCopy(SDL_Renderer * r, SDL_Texture * texture, const SDL_Rect * source, const SDL_Rect * target)
+{
+	RenderStats::Count(RenderStats::STATS_DRAW_CALLS);
+	return SDL_RenderCopy(r, texture, source, target);
+}
+__inline int StatsRenderDrawLine(SDL_Renderer * r, int x1, int y1, int x2, int y2)
+{
+	RenderStats::Count(RenderStats::STATS_DRAW_CALLS);
+	return SDL_RenderDrawLine(r, x1, y1, x2, y2);
+}
+__inline int StatsRenderDrawLines(SDL_Renderer * r, const SDL_Point * points, int count)
+{
+	RenderStats::Count(RenderStats::STATS_DRAW_CALLS);
+	return SDL_RenderDrawLines(r, points, count);
+}
+__inline int StatsRenderDrawRect(SDL_Renderer * r, const SDL_Rect * rect)
+{
+	RenderStats::Count(RenderStats::STATS_DRAW_CALLS);
+	return SDL_RenderDrawRect(r, rect);
+}
+__inline int StatsRenderFillRect(SDL_Renderer * r, const SDL_Rect * rect)
+{
+	RenderStats::Count(RenderStats::STATS_DRAW_CALLS);
+	return SDL_RenderFillRect(r, rect);
+}
+__inline SDL_Texture * StatsCreateTextureFromSurface(SDL_Renderer * r, SDL_Surface * surface)
+{
+	RenderStats::Count(RenderStats::STATS_TEXTURE_UPLOADS);
+	return SDL_CreateTextureFromSurface(r, surface);
+}
+__inline TTF_Font * StatsOpenFont(const char * path, int size)
+{
+	RenderStats::Count(RenderStats::STATS_FONT_OPENS);
+	return TTF_OpenFont(path, size);
+}
+#pragma endregion
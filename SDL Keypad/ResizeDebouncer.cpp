@@ -0,0 +1,51 @@
+#include "ResizeDebouncer.h"
+
+ResizeDebouncer::ResizeDebouncer() :
+	stableW(0),
+	stableH(0),
+	windowW(0),
+	windowH(0),
+	lastChange(0),
+	settleTime(RESIZE_SETTLE_TIME),
+	settled(0),
+	skipped(0)
+{ }
+
+bool ResizeDebouncer::Update(int w, int h, Uint64 now)
+{
+	//	Returns true when the layout size changed
+	if(stableW == 0 && stableH == 0)
+	{
+		stableW = windowW = w;
+		stableH = windowH = h;
+		return true;
+	}
+
+	if(w != windowW || h != windowH)
+	{
+		//	A size replaced before settling never made it to the layout
+		if(IsResizing())
+			skipped++;
+		windowW = w;
+		windowH = h;
+		lastChange = now;
+	}
+
+	if(!IsResizing() || now - lastChange < settleTime)
+		return false;
+
+	stableW = windowW;
+	stableH = windowH;
+	settled++;
+	return true;
+}
+
+Uint64 ResizeDebouncer::GetTimeToSettle(Uint64 now) const
+{
+	//	Nothing to wait for when not resizing
+	if(!IsResizing())
+		return (Uint64)-1;
+
+	const Uint64 due = lastChange + settleTime;
+	return due > now ? due - now : 0;
+}
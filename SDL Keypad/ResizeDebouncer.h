@@ -0,0 +1,57 @@
+#pragma once
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Real milliseconds the window size must hold still before the layout follows it
+#define RESIZE_SETTLE_TIME 250
+#pragma endregion
+
+/*
+ * Keeps the layout size steady while the window is being
+ * resized.
+ * Dragging a window border produces a new size almost every
+ * frame, and each new size means a new layout: new label
+ * sizes to rasterize, new layer textures to build. Here the
+ * window size is sampled every frame, but the layout size
+ * only follows it once it held still for the settle time.
+ * In between, the engine keeps drawing the last stable
+ * layout, scaled to the window, reusing all cached labels
+ * and layers.
+ * The very first size is taken right away.
+ */
+class ResizeDebouncer
+{
+	// Fields
+public:
+protected:
+private:
+	int stableW;
+	int stableH;
+	int windowW;
+	int windowH;
+	Uint64 lastChange;	//	Real time the window size last changed
+	Uint32 settleTime;
+	Uint64 settled;		//	Resizes that reached the layout
+	Uint64 skipped;		//	Intermediate sizes that never did
+	// Constructors
+public:
+	ResizeDebouncer();
+protected:
+private:
+	// Methods
+public:
+	__inline void SetSettleTime(Uint32 milliseconds) { settleTime = milliseconds; }
+	bool Update(int w, int h, Uint64 now);
+	__inline bool IsResizing() const { return windowW != stableW || windowH != stableH; }
+	__inline int GetWidth() const { return stableW; }
+	__inline int GetHeight() const { return stableH; }
+	Uint64 GetTimeToSettle(Uint64 now) const;
+	__inline Uint64 GetSettledCount() const { return settled; }
+	__inline Uint64 GetSkippedCount() const { return skipped; }
+protected:
+private:
+};
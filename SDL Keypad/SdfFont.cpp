@@ -0,0 +1,251 @@
+#include "SdfFont.h"
+
+#pragma region C++ Includes
+#include <cmath>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Modules
+#include <SDL_ttf.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "RenderStats.h"
+#include "Charset.h"
+#pragma endregion
+
+SdfFont::SdfFont() :
+	baseSize(0),
+	spread(0),
+	cellH(0),
+	height(0),
+	loaded(false)
+{ }
+
+bool SdfFont::Load(const string & fontPath, int size, int distanceSpread)
+{
+	/*
+	 * Runs once, on the main thread, after TTF_Init: this is
+	 * the only FreeType work text will ever need.
+	 */
+	loaded = false;
+	glyphs.clear();
+	atlas.clear();
+
+	TTF_Font * font = StatsOpenFont(fontPath.c_str(), size);
+	if(!font)
+		return false;
+
+	baseSize = size;
+	spread = distanceSpread;
+	height = TTF_FontHeight(font);
+	cellH = height + 2 * spread;
+
+	const SDL_Color white = {255, 255, 255, 255};
+	glyphs.resize(SDF_LAST_GLYPH - SDF_FIRST_GLYPH + 1);
+	for(Uint32 c = SDF_FIRST_GLYPH; c <= SDF_LAST_GLYPH; c++)
+	{
+		Glyph & glyph = glyphs[c - SDF_FIRST_GLYPH];
+		glyph.advance = 0;
+		glyph.cellW = 0;
+		glyph.offset = atlas.size();
+
+		int advance;
+		if(!TTF_GlyphIsProvided32(font, c) || TTF_GlyphMetrics32(font, c, nullptr, nullptr, nullptr, nullptr, &advance) != 0)
+			continue;
+		glyph.advance = advance;
+
+		//	Rendered as a one character string: positioned on the pen and font height tall
+		SDL_Surface * rendered = TTF_RenderGlyph32_Blended(font, c, white);
+		if(!rendered)
+			continue;
+		SDL_Surface * coverage = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+		SDL_FreeSurface(rendered);
+		if(!coverage)
+			continue;
+
+		BuildField(coverage, glyph);
+		SDL_FreeSurface(coverage);
+	}
+
+	TTF_CloseFont(font);
+	loaded = true;
+	return true;
+}
+
+bool SdfFont::CanRender(const string & text) const
+{
+	if(!loaded)
+		return false;
+
+	size_t position = 0;
+	Uint32 codePoint;
+	while(position < text.size())
+		if(!Charset::DecodeUtf8(text, position, codePoint) || !GetGlyph(codePoint))
+			return false;
+
+	return true;
+}
+
+SDL_Surface * SdfFont::Render(const string & text, int size, const SDL_Color & color) const
+{
+	if(!loaded || size <= 0)
+		return nullptr;
+
+	//	Lay out the pen positions, in base size pixels
+	vector<const Glyph *> line;
+	vector<int> pens;
+	int pen = 0;
+	size_t position = 0;
+	Uint32 codePoint;
+	while(position < text.size())
+	{
+		if(!Charset::DecodeUtf8(text, position, codePoint))
+			return nullptr;
+		const Glyph * glyph = GetGlyph(codePoint);
+		if(!glyph)
+			return nullptr;
+
+		line.push_back(glyph);
+		pens.push_back(pen);
+		pen += glyph->advance;
+	}
+
+	const float scale = (float)size / baseSize;
+	const int w = SDL_max((int)ceilf(pen * scale), 1);
+	const int h = SDL_max((int)ceilf(height * scale), 1);
+	SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+	if(!surface)
+		return nullptr;
+	SDL_memset(surface->pixels, 0, (size_t)surface->pitch * h);
+
+	/*
+	 * Distances are normalized over 2 * spread base pixels, an
+	 * output pixel is 1 / scale base pixels: coverage goes from
+	 * 0 to 1 over one output pixel around the outline.
+	 */
+	const float sharpness = 2.0f * spread * scale;
+	const Uint32 rgb = ((Uint32)color.r << 16) | ((Uint32)color.g << 8) | color.b;
+
+	for(size_t g = 0; g < line.size(); g++)
+	{
+		const Glyph & glyph = *line[g];
+		if(glyph.cellW == 0)
+			continue;
+
+		//	Output columns touched by this glyph cell (padding included)
+		const int cellLeft = pens[g] - spread;
+		const int fromX = SDL_max((int)floorf(cellLeft * scale), 0);
+		const int toX = SDL_min((int)ceilf((cellLeft + glyph.cellW) * scale), w);
+
+		for(int y = 0; y < h; y++)
+		{
+			Uint32 * row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+			const float cellY = (y + 0.5f) / scale + spread - 0.5f;
+			for(int x = fromX; x < toX; x++)
+			{
+				const float cellX = (x + 0.5f) / scale - cellLeft - 0.5f;
+				const float distance = Sample(glyph, cellX, cellY);
+				const float coverage = SDL_clamp((distance - 0.5f) * sharpness + 0.5f, 0.0f, 1.0f);
+
+				//	Overlapping cells keep the strongest coverage
+				const Uint32 alpha = (Uint32)(coverage * color.a + 0.5f);
+				if(alpha > (row[x] >> 24))
+					row[x] = (alpha << 24) | rgb;
+			}
+		}
+	}
+
+	return surface;
+}
+
+const SdfFont::Glyph * SdfFont::GetGlyph(Uint32 codePoint) const
+{
+	if(codePoint < SDF_FIRST_GLYPH || codePoint > SDF_LAST_GLYPH)
+		return nullptr;
+
+	//	Glyphs the font doesn't provide (but spaces) can't be drawn
+	const Glyph & glyph = glyphs[codePoint - SDF_FIRST_GLYPH];
+	return glyph.advance > 0 ? &glyph : nullptr;
+}
+
+float SdfFont::Sample(const Glyph & glyph, float x, float y) const
+{
+	//	Bilinear filtering, out of the cell is far outside
+	const int x0 = (int)floorf(x);
+	const int y0 = (int)floorf(y);
+	const float fx = x - x0;
+	const float fy = y - y0;
+
+	const Uint8 * field = &atlas[glyph.offset];
+	float texels[2][2];
+	for(int dy = 0; dy < 2; dy++)
+		for(int dx = 0; dx < 2; dx++)
+		{
+			const int tx = x0 + dx;
+			const int ty = y0 + dy;
+			texels[dy][dx] = tx < 0 || ty < 0 || tx >= glyph.cellW || ty >= cellH ? 0.0f : field[(size_t)ty * glyph.cellW + tx] / 255.0f;
+		}
+
+	const float top = texels[0][0] + (texels[0][1] - texels[0][0]) * fx;
+	const float bottom = texels[1][0] + (texels[1][1] - texels[1][0]) * fx;
+	return top + (bottom - top) * fy;
+}
+
+void SdfFont::BuildField(const SDL_Surface * coverage, Glyph & glyph)
+{
+	/*
+	 * For each texel of the padded cell, look for the closest
+	 * texel on the other side of the outline within the spread.
+	 * Brute force, but it only runs once per glyph at startup.
+	 * The coverage of anti-aliased edge texels moves the outline
+	 * by a fraction of a texel, for smoother fields.
+	 */
+	const int w = coverage->w + 2 * spread;
+	const int h = cellH;
+	glyph.cellW = w;
+	glyph.offset = atlas.size();
+	atlas.resize(atlas.size() + (size_t)w * h);
+
+	//	Coverage of the padded cell, 0 to 1
+	vector<float> alpha((size_t)w * h, 0.0f);
+	for(int y = 0; y < coverage->h && y + spread < h; y++)
+	{
+		const Uint32 * row = (const Uint32 *)((const Uint8 *)coverage->pixels + (size_t)y * coverage->pitch);
+		for(int x = 0; x < coverage->w; x++)
+			alpha[(size_t)(y + spread) * w + x + spread] = (row[x] >> 24) / 255.0f;
+	}
+
+	Uint8 * field = &atlas[glyph.offset];
+	for(int y = 0; y < h; y++)
+		for(int x = 0; x < w; x++)
+		{
+			const float own = alpha[(size_t)y * w + x];
+			const bool inside = own >= 0.5f;
+
+			float nearest = (float)spread;
+			for(int dy = -spread; dy <= spread; dy++)
+			{
+				const int sy = y + dy;
+				if(sy < 0 || sy >= h)
+					continue;
+				for(int dx = -spread; dx <= spread; dx++)
+				{
+					const int sx = x + dx;
+					if(sx < 0 || sx >= w)
+						continue;
+					const float other = alpha[(size_t)sy * w + sx];
+					if((other >= 0.5f) == inside)
+						continue;
+
+					//	The outline sits between the two texels, where coverage crosses one half
+					const float distance = sqrtf((float)(dx * dx + dy * dy)) - 0.5f + fabsf(own - 0.5f);
+					if(distance < nearest)
+						nearest = distance;
+				}
+			}
+
+			const float signedDistance = inside ? nearest : -nearest;
+			field[(size_t)y * w + x] = (Uint8)SDL_clamp(128.0f + signedDistance * 127.0f / spread, 0.0f, 255.0f);
+		}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Size the glyphs are rasterized at, once, to build the distance fields
+#define SDF_BASE_SIZE 64
+//	Distance (in base size pixels) covered by the field on each side of the outline
+#define SDF_SPREAD 8
+//	Glyphs in the atlas: printable ASCII
+#define SDF_FIRST_GLYPH 32
+#define SDF_LAST_GLYPH 126
+#pragma endregion
+
+/*
+ * A signed distance field atlas of a font, to draw text at any
+ * size without going back to FreeType.
+ * Every glyph is rasterized once at a base size and turned into
+ * a distance field: each texel holds how far it is from the
+ * outline (0.5 on the outline, above inside, below outside).
+ * Text at any size is then composed on the CPU, sampling the
+ * fields with bilinear filtering and turning distances into
+ * anti-aliased coverage one output pixel wide, so edges stay
+ * sharp when scaled up, unlike a scaled bitmap.
+ * SDL2 renderers have no shaders to do the thresholding on the
+ * GPU, so composing surfaces is the portable way: it's plain
+ * arithmetic on read-only data, so any thread can compose.
+ * The resulting surfaces match TTF_RenderUTF8_Blended ones
+ * (ARGB8888, font height tall, color in RGB, coverage in alpha).
+ */
+class SdfFont
+{
+	// Fields
+public:
+protected:
+private:
+	typedef struct
+	{
+		int advance;		//	Base size pixels
+		int cellW;			//	Cell width, padding included
+		size_t offset;		//	First texel in the atlas
+	} Glyph;
+
+	vector<Glyph> glyphs;	//	Indexed by code point - SDF_FIRST_GLYPH
+	vector<Uint8> atlas;
+	int baseSize;
+	int spread;
+	int cellH;				//	Font height plus padding, the same for all cells
+	int height;
+	bool loaded;
+	// Constructors
+public:
+	SdfFont();
+protected:
+private:
+	// Methods
+public:
+	bool Load(const string & fontPath, int size = SDF_BASE_SIZE, int distanceSpread = SDF_SPREAD);
+	__inline bool IsLoaded() const { return loaded; }
+	__inline size_t GetMemory() const { return atlas.size(); }
+	bool CanRender(const string & text) const;
+	SDL_Surface * Render(const string & text, int size, const SDL_Color & color) const;
+protected:
+private:
+	const Glyph * GetGlyph(Uint32 codePoint) const;
+	float Sample(const Glyph & glyph, float x, float y) const;
+	void BuildField(const SDL_Surface * coverage, Glyph & glyph);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <atomic>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (only types and macros, no SDL runtime is needed here)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	POSIX shared memory segment the game publishes its state to
+#define SHARED_STATE_NAME "/sdl-keypad-state"
+#define SHARED_STATE_MAGIC 0x4B50534BU	//	"KSPK"
+#define SHARED_STATE_VERSION 1
+#define SHARED_STATE_MAX_CODE 16
+
+//	Game status
+#define SHARED_STATUS_PLAYING 0
+#define SHARED_STATUS_WON 1
+#define SHARED_STATUS_LOST 2
+
+//	Digit hints, as the code display colors them
+#define SHARED_HINT_NONE 0
+#define SHARED_HINT_CORRECT 1
+#define SHARED_HINT_CLOSE 2
+#define SHARED_HINT_WRONG 3
+#pragma endregion
+
+/*
+ * Maps a digit error (see GameRules::GetCharacterError) to the
+ * hint the code display colors it with. The game, spectators and
+ * tools all go through this, so the thresholds only live here.
+ */
+__inline Uint8 GetDigitHint(const Uint8 digitError)
+{
+	if(digitError < 1)	//	No error, correct digit
+		return SHARED_HINT_CORRECT;
+	if(digitError < 2)	//	Nearby digit, wrong but close
+		return SHARED_HINT_CLOSE;
+	return SHARED_HINT_WRONG;	//	The digit wasn't even close
+}
+
+/*
+ * What spectators get to see of the game: the code being input,
+ * the hints for it, stages and time left.
+ * Digits are code points, so readers don't need the charset.
+ * Hints are only set while the input is complete, as on screen.
+ */
+typedef struct
+{
+	Uint64 frame;			//	Publications so far, grows by one each frame
+	Uint32 timeLeft;		//	Milliseconds, as of that frame
+	Uint32 solveTime;		//	Milliseconds for the whole game
+	Uint8 stages;
+	Uint8 stagesLeft;
+	Uint8 codeLength;
+	Uint8 inputLength;
+	Uint8 status;
+	Uint8 reserved[3];
+	Uint32 input[SHARED_STATE_MAX_CODE];
+	Uint8 hints[SHARED_STATE_MAX_CODE];
+} SharedGameState;
+
+/*
+ * The shared memory segment layout, a seqlock around the state:
+ * the game (the only writer) makes the sequence odd, writes the
+ * state and makes it even again. Readers copy the state and
+ * keep the copy only if the sequence was the same even number
+ * before and after, so the game never waits for anybody.
+ */
+typedef struct
+{
+	Uint32 magic;
+	Uint32 version;
+	atomic<Uint32> sequence;
+	Uint32 reserved;
+	SharedGameState state;
+} SharedStateSegment;
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "The seqlock needs lock-free atomics to work across processes");
+static_assert(sizeof(SharedGameState) == 104, "SharedGameState layout must be the same for every build");
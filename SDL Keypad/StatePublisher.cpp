@@ -0,0 +1,90 @@
+#include "StatePublisher.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#include <new>
+#pragma endregion
+
+//	POSIX shared memory, not on Windows nor in the browser
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define SHARED_STATE_SUPPORTED
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+StatePublisher::StatePublisher() :
+	segment(nullptr),
+	frame(0)
+{ }
+
+StatePublisher::~StatePublisher()
+{
+	Close();
+}
+
+bool StatePublisher::Open(const string & segmentName)
+{
+#ifdef SHARED_STATE_SUPPORTED
+	if(segment)
+		return true;
+
+	const int fd = shm_open(segmentName.c_str(), O_CREAT | O_RDWR, 0644);
+	if(fd < 0)
+		return false;
+
+	void * memory = MAP_FAILED;
+	if(ftruncate(fd, sizeof(SharedStateSegment)) == 0)
+		memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if(memory == MAP_FAILED)
+	{
+		shm_unlink(segmentName.c_str());
+		return false;
+	}
+
+	//	Readers check the header before trusting anything else
+	segment = new(memory) SharedStateSegment();
+	segment->version = SHARED_STATE_VERSION;
+	segment->sequence.store(0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	segment->magic = SHARED_STATE_MAGIC;
+
+	name = segmentName;
+	frame = 0;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void StatePublisher::Close()
+{
+#ifdef SHARED_STATE_SUPPORTED
+	if(!segment)
+		return;
+
+	//	Readers keep their mapping, new ones won't find the game anymore
+	segment->magic = 0;
+	munmap(segment, sizeof(SharedStateSegment));
+	shm_unlink(name.c_str());
+	segment = nullptr;
+#endif
+}
+
+void StatePublisher::Publish(const SharedGameState & state)
+{
+	if(!segment)
+		return;
+
+	//	Odd while writing, even again once done
+	const Uint32 sequence = segment->sequence.load(memory_order_relaxed);
+	segment->sequence.store(sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	memcpy(&segment->state, &state, sizeof(state));
+	segment->state.frame = ++frame;
+
+	segment->sequence.store(sequence + 2, memory_order_release);
+}
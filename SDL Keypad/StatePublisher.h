@@ -0,0 +1,52 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "SharedState.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Publishes the game state to a POSIX shared memory segment,
+ * for external processes such as a stream overlay (see
+ * SharedState.h for the layout and the reading protocol).
+ * Publishing copies a hundred bytes between two atomic stores:
+ * it never blocks, whatever readers do.
+ * Where POSIX shared memory isn't available (Windows, the web
+ * build) it can't be opened and publishing does nothing.
+ */
+class StatePublisher
+{
+	// Fields
+public:
+protected:
+private:
+	string name;
+	SharedStateSegment * segment;
+	Uint64 frame;
+	// Constructors
+public:
+	StatePublisher();
+	~StatePublisher();
+	StatePublisher(const StatePublisher &) = delete;
+	StatePublisher & operator=(const StatePublisher &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Open(const string & segmentName = SHARED_STATE_NAME);
+	void Close();
+	__inline bool IsOpen() const { return segment != nullptr; }
+	void Publish(const SharedGameState & state);
+protected:
+private:
+};
@@ -0,0 +1,142 @@
+#include "StatsOverlay.h"
+
+#pragma region C++ Includes
+#include <sstream>
+#include <iomanip>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Utilities.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Color palette
+#define COL_OVERLAY 255, 220, 0, 255
+#define SDL_COL_OVERLAY SDL_Color{COL_OVERLAY}
+#define COL_OVERLAY_BG 0, 0, 0, 160
+#define COL_OVERLAY_GUIDE 255, 220, 0, 96
+
+//	Layout
+#define OVERLAY_TEXT_SIZE 18
+#define OVERLAY_MARGIN 16
+#define OVERLAY_TOP 48
+#define OVERLAY_WIDTH 360
+#define OVERLAY_GRAPH_HEIGHT 64
+
+//	The graph spans two 60 FPS frames, the guide marks one
+#define OVERLAY_GRAPH_MAX_MS 33.3f
+#define OVERLAY_GRAPH_GUIDE_MS 16.7f
+
+//	Refresh rate of the printed values
+#define OVERLAY_REFRESH_TICKS 500
+#pragma endregion
+
+StatsOverlay::StatsOverlay() :
+	visible(false),
+	textTicks(0)
+{ }
+
+void StatsOverlay::SetVisible(bool show)
+{
+	//	Counting costs something, only do it while there's someone looking
+	visible = show;
+	RenderStats::SetEnabled(show);
+	fpsText = TextRun();
+	countersText = TextRun();
+}
+
+Uint64 StatsOverlay::GetIdleTime() const
+{
+	//	Hidden, nothing to refresh (and frames only change the stats when they run anyway)
+	if(!visible)
+		return IDLE_FOREVER;
+
+	return OVERLAY_REFRESH_TICKS;
+}
+
+void StatsOverlay::Render(SDL_Renderer * r) const
+{
+	TRACE_SCOPE("StatsOverlay::Render");
+
+	if(!visible)
+		return;
+
+	//	Check viewport aera is valid
+	SDL_Rect const * areaPtr = GetViewportArea();
+
+	//	If no viewport area is set, prevent render
+	if(!areaPtr)
+		return;
+
+	const SDL_Rect & area = *areaPtr;
+
+	//	Refresh the text only every now and then
+	const Uint64 now = SDL_GetTicks64();
+	if(fpsText.IsEmpty() || now >= textTicks + OVERLAY_REFRESH_TICKS)
+	{
+		ostringstream fpsStream;
+		fpsStream << fixed << setprecision(1);
+		fpsStream << "FPS " << RenderStats::GetFps() << " FRAME " << RenderStats::GetFrameTime(0) << " MS";
+		fpsText.Set(fpsStream.str(), SDL_COL_OVERLAY, OVERLAY_TEXT_SIZE);
+
+		ostringstream countersStream;
+		countersStream << "DRAW " << RenderStats::GetLastFrame(RenderStats::STATS_DRAW_CALLS);
+		countersStream << " UPLOAD " << RenderStats::GetLastFrame(RenderStats::STATS_TEXTURE_UPLOADS);
+		countersStream << " FONT " << RenderStats::GetLastFrame(RenderStats::STATS_FONT_OPENS);
+		countersStream << " ALLOC " << RenderStats::GetLastFrame(RenderStats::STATS_ALLOCATIONS);
+		countersText.Set(countersStream.str(), SDL_COL_OVERLAY, OVERLAY_TEXT_SIZE);
+
+		textTicks = now;
+	}
+
+	//	Background panel: two lines of text and the graph
+	const int lineHeight = OVERLAY_TEXT_SIZE + OVERLAY_MARGIN / 2;
+	SDL_Rect panel;
+	panel.x = area.x + OVERLAY_MARGIN;
+	panel.y = area.y + OVERLAY_TOP;
+	panel.w = SDL_min(OVERLAY_WIDTH, area.w - 2 * OVERLAY_MARGIN);
+	panel.h = 2 * lineHeight + OVERLAY_GRAPH_HEIGHT + OVERLAY_MARGIN;
+	if(panel.w <= 0)
+		return;
+
+	//	Translucent, leaving the draw blend mode as the other elements expect it
+	SDL_BlendMode previousBlendMode;
+	SDL_GetRenderDrawBlendMode(r, &previousBlendMode);
+	SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(r, COL_OVERLAY_BG);
+	StatsRenderFillRect(r, &panel);
+
+	RenderLabel(r, fpsText, panel.x + panel.w / 2, panel.y + lineHeight / 2);
+	RenderLabel(r, countersText, panel.x + panel.w / 2, panel.y + lineHeight + lineHeight / 2);
+
+	SDL_Rect graphArea;
+	graphArea.x = panel.x + OVERLAY_MARGIN / 2;
+	graphArea.y = panel.y + 2 * lineHeight;
+	graphArea.w = panel.w - OVERLAY_MARGIN;
+	graphArea.h = OVERLAY_GRAPH_HEIGHT;
+	RenderGraph(r, graphArea);
+
+	SDL_SetRenderDrawBlendMode(r, previousBlendMode);
+}
+
+void StatsOverlay::RenderGraph(SDL_Renderer * r, const SDL_Rect & graphArea) const
+{
+	//	Guide line at the 60 FPS budget
+	const int guideY = graphArea.y + graphArea.h - (int)(graphArea.h * OVERLAY_GRAPH_GUIDE_MS / OVERLAY_GRAPH_MAX_MS);
+	SDL_SetRenderDrawColor(r, COL_OVERLAY_GUIDE);
+	StatsRenderDrawLine(r, graphArea.x, guideY, graphArea.x + graphArea.w, guideY);
+
+	//	Oldest frame on the left, a single polyline for the whole history
+	SDL_Point points[STATS_HISTORY_FRAMES];
+	for(int f = 0; f < STATS_HISTORY_FRAMES; f++)
+	{
+		const float frameTime = SDL_min(RenderStats::GetFrameTime(STATS_HISTORY_FRAMES - 1 - f), OVERLAY_GRAPH_MAX_MS);
+		points[f].x = graphArea.x + f * graphArea.w / (STATS_HISTORY_FRAMES - 1);
+		points[f].y = graphArea.y + graphArea.h - (int)(graphArea.h * frameTime / OVERLAY_GRAPH_MAX_MS);
+	}
+
+	SDL_SetRenderDrawColor(r, COL_OVERLAY);
+	StatsRenderDrawLines(r, points, STATS_HISTORY_FRAMES);
+}
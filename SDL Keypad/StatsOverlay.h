@@ -0,0 +1,56 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "IRenderable.h"
+#include "TextRun.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Debug overlay showing the runtime stats of the last frame
+ * (FPS, draw calls, texture uploads, font opens, allocations)
+ * and a graph of the recent frame times, in the top left corner
+ * of its viewport area.
+ * The numbers are refreshed a couple of times per second, so
+ * they stay readable and don't create a new label every frame,
+ * while the graph follows every frame.
+ * Stats are only counted while the overlay is visible.
+ */
+class StatsOverlay : public IRenderable
+{
+	// Fields
+public:
+protected:
+private:
+	bool visible;
+	mutable TextRun fpsText;
+	mutable TextRun countersText;
+	mutable Uint64 textTicks;
+	// Constructors
+public:
+	StatsOverlay();
+protected:
+private:
+	// Methods
+public:
+	void SetVisible(bool show);
+	__inline bool IsVisible() const { return visible; }
+	__inline void ToggleVisible() { SetVisible(!visible); }
+
+	//	IRenderable implementation
+	void Render(SDL_Renderer * r) const override;
+	Uint64 GetIdleTime() const override;
+protected:
+private:
+	void RenderGraph(SDL_Renderer * r, const SDL_Rect & graphArea) const;
+};
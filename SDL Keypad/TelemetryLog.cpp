@@ -0,0 +1,177 @@
+#include "TelemetryLog.h"
+
+#pragma region C++ Includes
+#include <chrono>
+#pragma endregion
+
+//	Durable writes: fsync on POSIX, _commit on Windows, nothing to sync to in the browser
+#if defined(_WIN32)
+#include <io.h>
+#define SyncFile(f) _commit(_fileno(f))
+#elif defined(__EMSCRIPTEN__)
+#define SyncFile(f) 0
+#else
+#include <unistd.h>
+#define SyncFile(f) fsync(fileno(f))
+#endif
+
+static Uint64 GetMilliseconds()
+{
+	return (Uint64)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TelemetryLog::TelemetryLog() :
+	head(0),
+	tail(0),
+	dropped(0),
+	origin(0),
+	file(nullptr),
+	written(0),
+	failed(0),
+	lastSync(0),
+	stopping(false),
+	running(false)
+{ }
+
+TelemetryLog::~TelemetryLog()
+{
+	Stop();
+}
+
+bool TelemetryLog::Start(const string & path)
+{
+	if(running)
+		return false;
+
+	file = fopen(path.c_str(), "ab");
+	if(!file)
+		return false;
+
+	//	Batches are written whole anyway: unbuffered, fwrite tells what actually reached the file
+	setvbuf(file, nullptr, _IONBF, 0);
+
+	//	Each run starts with its own header, so runs can be told apart in an appended file
+	const TelemetryFileHeader header = {
+		TELEMETRY_MAGIC,
+		TELEMETRY_VERSION,
+		(Uint16)sizeof(TelemetryRecord),
+		(Uint64)chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count()
+	};
+	if(fwrite(&header, sizeof(header), 1, file) != 1)
+	{
+		fclose(file);
+		file = nullptr;
+		return false;
+	}
+
+	ring.resize(TELEMETRY_RING_SIZE);
+	head.store(0, memory_order_relaxed);
+	tail.store(0, memory_order_relaxed);
+	dropped.store(0, memory_order_relaxed);
+	origin = GetMilliseconds();
+	lastSync = origin;
+	written.store(0, memory_order_relaxed);
+	failed.store(0, memory_order_relaxed);
+
+	stopping = false;
+	running = true;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	//	No threads to write on: the ring gets written on Stop
+#else
+	writer = thread(&TelemetryLog::WriterLoop, this);
+#endif
+	return true;
+}
+
+void TelemetryLog::Stop()
+{
+	if(!running)
+		return;
+
+	{
+		lock_guard<mutex> lock(writerLock);
+		stopping = true;
+	}
+	wake.notify_one();
+	if(writer.joinable())
+		writer.join();
+
+	//	Whatever is left, durably
+	Flush();
+	Sync();
+	fclose(file);
+	file = nullptr;
+	running = false;
+}
+
+bool TelemetryLog::Append(const TelemetryRecord & record)
+{
+	//	The ring is full when the writer is a whole lap behind
+	const Uint64 position = head.load(memory_order_relaxed);
+	if(!running || position - tail.load(memory_order_acquire) >= TELEMETRY_RING_SIZE)
+	{
+		dropped.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+
+	TelemetryRecord & slot = ring[position & (TELEMETRY_RING_SIZE - 1)];
+	slot = record;
+	slot.time = GetMilliseconds() - origin;
+
+	//	Publish the record to the writer
+	head.store(position + 1, memory_order_release);
+	return true;
+}
+
+void TelemetryLog::WriterLoop()
+{
+	unique_lock<mutex> lock(writerLock);
+	while(!stopping)
+	{
+		wake.wait_for(lock, chrono::milliseconds(TELEMETRY_FLUSH_INTERVAL));
+		if(stopping)
+			break;
+
+		lock.unlock();
+		Flush();
+		if(GetMilliseconds() - lastSync >= TELEMETRY_SYNC_INTERVAL)
+			Sync();
+		lock.lock();
+	}
+}
+
+void TelemetryLog::Flush()
+{
+	/*
+	 * Everything between tail and head is ready: write it in at
+	 * most two runs (before and after the end of the ring), then
+	 * hand the slots back to the game.
+	 */
+	const Uint64 from = tail.load(memory_order_relaxed);
+	const Uint64 to = head.load(memory_order_acquire);
+	if(from == to)
+		return;
+
+	const size_t first = (size_t)(from & (TELEMETRY_RING_SIZE - 1));
+	const size_t count = (size_t)(to - from);
+	const size_t firstRun = SDL_min(count, (size_t)TELEMETRY_RING_SIZE - first);
+	size_t done = fwrite(&ring[first], sizeof(TelemetryRecord), firstRun, file);
+	if(done == firstRun && count > firstRun)
+		done += fwrite(&ring[0], sizeof(TelemetryRecord), count - firstRun, file);
+
+	if(done < count)
+	{
+		//	The slots are handed back anyway, the game must not stall on a full disk; later batches try again
+		failed.fetch_add(count - done, memory_order_relaxed);
+		clearerr(file);
+	}
+
+	written.fetch_add(done, memory_order_relaxed);
+	tail.store(to, memory_order_release);
+}
+
+void TelemetryLog::Sync()
+{
+	SyncFile(file);
+	lastSync = GetMilliseconds();
+}
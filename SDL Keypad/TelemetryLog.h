@@ -0,0 +1,139 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (only types and macros, no SDL runtime is needed here)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Charset.h"
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Records the game can get ahead of the writer by (a power of two)
+#define TELEMETRY_RING_SIZE 4096
+//	How often the background thread writes records out, and syncs them to disk
+#define TELEMETRY_FLUSH_INTERVAL 100
+#define TELEMETRY_SYNC_INTERVAL 2000
+
+//	File layout
+#define TELEMETRY_MAGIC 0x4C544B50U	//	"PKTL"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_MAX_CODE 16
+
+//	Record flags
+#define TELEMETRY_FLAG_MATCH 0x01	//	Submission: the code was right
+#pragma endregion
+
+enum class TelemetryEvent : Uint8
+{
+	GameStart = 1,		//	A new session begins
+	Submission,			//	A complete code was submitted, with its errors
+	StageCleared,
+	GameWon,
+	GameLost,			//	Time ran out
+	Restart				//	The player asked for a new game from the game over screen
+};
+
+/*
+ * One event, as stored in the file: fixed size, so files can be
+ * read (and skipped through) without parsing. Times are in
+ * milliseconds: since the log started (see the file header) and
+ * left to the end of the game.
+ */
+typedef struct
+{
+	Uint64 time;
+	Uint32 session;
+	Uint32 timeLeft;
+	Uint8 type;			//	TelemetryEvent
+	Uint8 stagesLeft;
+	Uint8 codeLength;
+	Uint8 flags;
+	Uint8 digitErrors[TELEMETRY_MAX_CODE];	//	Submission only
+	CharIndex input[TELEMETRY_MAX_CODE];	//	Submission only, charset slots
+	Uint32 reserved;
+} TelemetryRecord;
+
+/*
+ * Starts every telemetry file, records follow until its end.
+ */
+typedef struct
+{
+	Uint32 magic;
+	Uint16 version;
+	Uint16 recordSize;
+	Uint64 startTime;	//	Unix time in milliseconds, when the log started
+} TelemetryFileHeader;
+
+static_assert(sizeof(TelemetryRecord) == 72, "TelemetryRecord layout must be the same for every build");
+static_assert(sizeof(TelemetryFileHeader) == 16, "TelemetryFileHeader layout must be the same for every build");
+
+/*
+ * Appends game events to a binary file for offline analytics.
+ * The game thread copies fixed-size records into a lock-free
+ * single producer, single consumer ring, a background thread
+ * takes them in batches, appends them to the file and syncs it
+ * to disk every couple of seconds: the game never touches the
+ * filesystem and never waits. If the writer falls a whole ring
+ * behind, new records are dropped (and counted) rather than
+ * blocking the frame. Records the file refuses are counted
+ * apart, so only records actually written count as written.
+ * Only one thread may append. A log records one run, from Start
+ * to Stop, and appends to the file if it already exists.
+ */
+class TelemetryLog
+{
+	// Fields
+public:
+protected:
+private:
+	vector<TelemetryRecord> ring;
+	alignas(64) atomic<Uint64> head;	//	Written by the game thread only
+	alignas(64) atomic<Uint64> tail;	//	Written by the writer only
+	alignas(64) atomic<Uint64> dropped;
+	Uint64 origin;
+	FILE * file;
+	atomic<Uint64> written;		//	Written by the writer only
+	atomic<Uint64> failed;		//	Records the file refused (disk full, I/O error)
+	Uint64 lastSync;
+	thread writer;
+	mutex writerLock;
+	condition_variable wake;
+	bool stopping;
+	bool running;
+	// Constructors
+public:
+	TelemetryLog();
+	~TelemetryLog();
+	TelemetryLog(const TelemetryLog &) = delete;
+	TelemetryLog & operator=(const TelemetryLog &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Start(const string & path);
+	void Stop();
+	__inline bool IsRunning() const { return running; }
+	bool Append(const TelemetryRecord & record);
+	__inline Uint64 GetWritten() const { return written.load(memory_order_relaxed); }
+	__inline Uint64 GetFailed() const { return failed.load(memory_order_relaxed); }
+	__inline Uint64 GetDropped() const { return dropped.load(memory_order_relaxed); }
+protected:
+private:
+	void WriterLoop();
+	void Flush();
+	void Sync();
+};
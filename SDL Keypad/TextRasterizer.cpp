@@ -0,0 +1,354 @@
+#include "TextRasterizer.h"
+
+#pragma region C++ Includes
+#include <iomanip>
+#pragma endregion
+
+#pragma region Game Includes
+#include "RenderStats.h"
+#include "TraceLog.h"
+#pragma endregion
+
+TextRasterizer::TextRasterizer() :
+	jobs(nullptr),
+	pendingCount(0),
+	jobsInFlight(0),
+	finishedJobs(0),
+	memoryBudget(TEXT_CACHE_DEFAULT_BUDGET),
+	memoryInUse(0),
+	frame(0),
+	evictions(0)
+{ }
+
+TextRasterizer::~TextRasterizer()
+{
+	Shutdown();
+}
+
+bool TextRasterizer::Draw(SDL_Renderer * r, const char * text, size_t length, int posX, int posY, const SDL_Color & color, int size)
+{
+	//	The key is built in a reused buffer, no allocation once it's large enough
+	MakeKey(text, length, color, size, lookupKey);
+	return Draw(r, lookupKey, text, length, posX, posY, color, size);
+}
+
+bool TextRasterizer::Draw(SDL_Renderer * r, const TextRun & run, int posX, int posY)
+{
+	//	Runs come with their key already built
+	const string & text = run.GetText();
+	return Draw(r, run.GetKey(), text.data(), text.size(), posX, posY, run.GetColor(), run.GetSize());
+}
+
+bool TextRasterizer::Draw(SDL_Renderer * r, const string & key, const char * text, size_t length, int posX, int posY, const SDL_Color & color, int size)
+{
+	//	Find the label or request it (the key may be the lookup buffer: it's not used past this point)
+	Label * label;
+	unordered_map<string, Label *>::iterator it = labels.find(key);
+	if(it != labels.end())
+	{
+		//	Most recently drawn goes first
+		label = it->second;
+		lru.splice(lru.begin(), lru, label->lruPosition);
+	}
+	else
+	{
+		label = new Label();
+		label->text.assign(text, length);
+		label->size = size;
+		label->color = color;
+		label->state = LABEL_PENDING;
+		label->surface = nullptr;
+		label->texture = nullptr;
+		label->w = 0;
+		label->h = 0;
+		label->pending = true;
+		label->key = key;
+		label->bytes = 0;
+		labels[label->key] = label;
+		lru.push_front(label);
+		label->lruPosition = lru.begin();
+		pendingCount++;
+		pendingLabels.push_back(label);
+
+		//	Nobody waits on these jobs, past the cap new labels are rasterized right here
+		if(jobs && jobs->GetWorkersCount() > 0 && jobsInFlight < TEXT_MAX_JOBS_IN_FLIGHT)
+		{
+			jobsInFlight++;
+			jobs->Run(jobs->Create([this, label]()
+			{
+				Rasterize(label);
+				finishedJobs.fetch_add(1, memory_order_release);
+			}));
+		}
+		else
+			Rasterize(label);
+	}
+
+	label->lastFrame = frame;
+
+	//	Turn a freshly rasterized surface into a texture, this is the only part running on the render thread
+	int state = label->state.load(memory_order_acquire);
+	if(state == LABEL_RASTERIZED)
+	{
+		state = Upload(r, label) ? LABEL_READY : LABEL_FAILED;
+		if(memoryInUse > memoryBudget)
+			Evict();
+	}
+
+	//	The label is settled either way
+	if(label->pending && state != LABEL_PENDING)
+		Settle(label);
+
+	switch(state)
+	{
+		case LABEL_READY:
+			DrawTexture(r, label, posX, posY, label->w, label->h);
+			return true;
+		case LABEL_FAILED:
+		{
+			/*
+			 * When fonts don't get loaded this game is impossible to try so
+			 * let's at least draw a small rect so we know that the font
+			 * wasn't loaded but still we can test the game.
+			 */
+			SDL_Rect missingFontArea{posX - size / 2, posY - size / 2, size, size};
+			SDL_SetRenderDrawColor(r, color.r, color.g, color.b, color.a);
+			StatsRenderDrawRect(r, &missingFontArea);
+			return true;
+		}
+	}
+
+	//	Still rasterizing: stretch the same text at its last known size, if any
+	MakeKey(text, length, color, 0, lookupKey);
+	unordered_map<string, Label *>::const_iterator latest = latestByText.find(lookupKey);
+	if(latest != latestByText.end())
+	{
+		const Label * placeholder = latest->second;
+		DrawTexture(r, placeholder, posX, posY, placeholder->w * size / placeholder->size, placeholder->h * size / placeholder->size);
+	}
+
+	return false;
+}
+
+void TextRasterizer::NextFrame()
+{
+	/*
+	 * Labels that finished without being drawn again would stay
+	 * pending forever (and keep the game from idling): settle
+	 * them here. Surfaces nobody drew this frame are off screen,
+	 * they're freed instead of waiting for an upload that may
+	 * never come.
+	 */
+	const int finished = finishedJobs.exchange(0, memory_order_acquire);
+	jobsInFlight -= finished;
+	for(size_t p = 0; finished > 0 && p < pendingLabels.size(); )
+	{
+		Label * label = pendingLabels[p];
+		const int state = label->state.load(memory_order_acquire);
+		if(state == LABEL_PENDING)
+		{
+			p++;
+			continue;
+		}
+
+		//	Both remove the label from the pending ones
+		if(state == LABEL_RASTERIZED && label->lastFrame != frame)
+			Destroy(label);
+		else
+			Settle(label);
+	}
+
+	if(memoryInUse > memoryBudget)
+		Evict();
+
+	frame++;
+}
+
+bool TextRasterizer::LoadSdfFont()
+{
+	//	Must run after TTF_Init, on the main thread, before any label gets requested
+	return sdf.Load(fontPath);
+}
+
+void TextRasterizer::Shutdown()
+{
+	/*
+	 * Must run after the job system stopped (no rasterization
+	 * can be in progress) and before TTF_Quit.
+	 */
+	while(!lru.empty())
+		Destroy(lru.back());
+	pendingCount = 0;
+	pendingLabels.clear();
+	jobsInFlight = 0;
+	finishedJobs = 0;
+
+	lock_guard<mutex> lock(fontsLock);
+	for(pair<const thread::id, TTF_Font *> & font : fonts)
+		TTF_CloseFont(font.second);
+	fonts.clear();
+}
+
+void TextRasterizer::MakeKey(const string & text, const SDL_Color & color, int size, string & key)
+{
+	MakeKey(text.data(), text.size(), color, size, key);
+}
+
+void TextRasterizer::MakeKey(const char * text, size_t length, const SDL_Color & color, int size, string & key)
+{
+	//	Text first, then fixed-size binary fields after a separator that can't appear in UTF-8 text
+	key.assign(text, length);
+	key.push_back('\0');
+	key.append((const char *)&color, sizeof(color));
+	key.append((const char *)&size, sizeof(size));
+}
+
+TTF_Font * TextRasterizer::GetThreadFont(int size)
+{
+	/*
+	 * Opening a font goes through the FreeType library shared by
+	 * all fonts, so it happens under the lock. Rendering with a
+	 * font owned by the current thread doesn't need it.
+	 */
+	TTF_Font * font;
+	{
+		lock_guard<mutex> lock(fontsLock);
+		TTF_Font *& threadFont = fonts[this_thread::get_id()];
+		if(!threadFont)
+			threadFont = StatsOpenFont(fontPath.c_str(), size);
+		font = threadFont;
+	}
+
+	if(font)
+		TTF_SetFontSize(font, size);
+
+	return font;
+}
+
+void TextRasterizer::Rasterize(Label * label)
+{
+	TRACE_SCOPE("TextRasterizer::Rasterize");
+
+	//	Runs on any thread: only touches this label, the read-only atlas and the thread's own font
+	if(sdf.CanRender(label->text))
+		label->surface = sdf.Render(label->text, label->size, label->color);
+	else
+	{
+		TTF_Font * font = GetThreadFont(label->size);
+		if(font)
+			label->surface = TTF_RenderUTF8_Blended(font, label->text.c_str(), label->color);
+	}
+
+	label->state.store(label->surface ? LABEL_RASTERIZED : LABEL_FAILED, memory_order_release);
+}
+
+void TextRasterizer::Settle(Label * label)
+{
+	label->pending = false;
+	pendingCount--;
+	for(size_t p = 0; p < pendingLabels.size(); p++)
+		if(pendingLabels[p] == label)
+		{
+			pendingLabels[p] = pendingLabels.back();
+			pendingLabels.pop_back();
+			break;
+		}
+
+	//	A surface waiting for its upload takes memory too
+	if(label->surface)
+	{
+		label->bytes = (size_t)label->surface->pitch * label->surface->h;
+		memoryInUse += label->bytes;
+	}
+}
+
+bool TextRasterizer::Upload(SDL_Renderer * r, Label * label)
+{
+	TRACE_SCOPE("TextRasterizer::Upload");
+
+	label->texture = StatsCreateTextureFromSurface(r, label->surface);
+	label->w = label->surface->w;
+	label->h = label->surface->h;
+	SDL_FreeSurface(label->surface);
+	label->surface = nullptr;
+	memoryInUse -= label->bytes;
+	label->bytes = 0;
+
+	label->state.store(label->texture ? LABEL_READY : LABEL_FAILED, memory_order_relaxed);
+	if(label->texture)
+	{
+		label->bytes = (size_t)label->w * label->h * 4;
+		memoryInUse += label->bytes;
+		MakeKey(label->text, label->color, 0, lookupKey);
+		latestByText[lookupKey] = label;
+	}
+
+	return label->texture != nullptr;
+}
+
+void TextRasterizer::PrintReport(ostream & out) const
+{
+	out << "Label cache: " << labels.size() << " labels, ";
+	out << fixed << setprecision(2) << memoryInUse / (1024.0 * 1024.0) << " / " << memoryBudget / (1024.0 * 1024.0) << " MB, ";
+	out << evictions << " evictions";
+	if(sdf.IsLoaded())
+		out << ", " << sdf.GetMemory() / 1024 << " KB distance field atlas";
+	out << endl;
+}
+
+void TextRasterizer::Evict()
+{
+	/*
+	 * Drop the least recently drawn labels until back within
+	 * budget. Labels drawn this frame are in use, and labels
+	 * still pending may be in a worker's hands: both stay, even
+	 * if that means staying over budget for a while.
+	 */
+	list<Label *>::iterator it = lru.end();
+	while(memoryInUse > memoryBudget && it != lru.begin())
+	{
+		Label * label = *--it;
+		if(label->lastFrame == frame || label->state.load(memory_order_acquire) == LABEL_PENDING)
+			continue;
+
+		it = lru.erase(it);
+		label->lruPosition = lru.end();
+		Destroy(label);
+		evictions++;
+	}
+}
+
+void TextRasterizer::Destroy(Label * label)
+{
+	//	Only the render thread gets here, with no worker touching the label
+	if(label->lruPosition != lru.end())
+		lru.erase(label->lruPosition);
+	labels.erase(label->key);
+
+	MakeKey(label->text, label->color, 0, lookupKey);
+	unordered_map<string, Label *>::iterator latest = latestByText.find(lookupKey);
+	if(latest != latestByText.end() && latest->second == label)
+		latestByText.erase(latest);
+
+	if(label->pending)
+		Settle(label);
+	memoryInUse -= label->bytes;
+
+	if(label->texture)
+		SDL_DestroyTexture(label->texture);
+	if(label->surface)
+		SDL_FreeSurface(label->surface);
+	delete label;
+}
+
+void TextRasterizer::DrawTexture(SDL_Renderer * r, const Label * label, int posX, int posY, int w, int h) const
+{
+	//	Labels are centered on the given position
+	SDL_Rect target;
+	target.w = w;
+	target.h = h;
+	target.x = posX - target.w / 2;
+	target.y = posY - target.h / 2;
+
+	StatsRenderCopy(r, label->texture, nullptr, &target);
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <list>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+
+//	SDL Modules
+#include <SDL_ttf.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "JobSystem.h"
+#include "SdfFont.h"
+#include "TextRun.h"
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Default texture memory the label cache may use
+#define TEXT_CACHE_DEFAULT_BUDGET (16 * 1024 * 1024)
+//	Rasterization jobs in flight at once: unwaited roots hold their ring slot until finished, half a ring block keeps it from growing
+#define TEXT_MAX_JOBS_IN_FLIGHT (JOB_ROOTS_POOL_SIZE / 2)
+#pragma endregion
+
+/*
+ * Rasterizes labels away from the render thread.
+ * The first time a (text, size, color) label is requested, a job
+ * renders it to an SDL_Surface on a worker thread; the render
+ * thread only turns finished surfaces into textures and draws
+ * them. Until a label is ready, the same text at its last known
+ * size is drawn stretched as a placeholder (or nothing at all,
+ * for brand new text).
+ * Once the signed distance field atlas is loaded, labels are
+ * composed from it at any size with no FreeType work at all (the
+ * atlas is read-only, so workers share it). Text the atlas can't
+ * draw falls back to SDL_ttf: its fonts aren't thread-safe, so
+ * every thread gets its own TTF_Font handle, opened on demand and
+ * resized as needed.
+ * Without worker threads, labels are rasterized synchronously,
+ * and so are new labels past TEXT_MAX_JOBS_IN_FLIGHT.
+ * Labels finishing without being drawn again are settled at the
+ * end of the frame: surfaces nobody drew in that frame are freed
+ * right away, the others count against the budget until their
+ * upload.
+ * Finished labels are cached as textures, within a memory
+ * budget: when it's exceeded, the least recently drawn labels
+ * are dropped (never the ones drawn in the current frame, nor
+ * the ones a worker is still rasterizing).
+ */
+class TextRasterizer
+{
+	// Fields
+public:
+protected:
+private:
+	enum LabelState : int
+	{
+		LABEL_PENDING,
+		LABEL_RASTERIZED,
+		LABEL_READY,
+		LABEL_FAILED
+	};
+
+	typedef struct Label
+	{
+		string text;
+		int size;
+		SDL_Color color;
+		atomic<int> state;
+		SDL_Surface * surface;	//	Written by the worker, consumed by the render thread
+		SDL_Texture * texture;
+		int w;
+		int h;
+		bool pending;			//	Render thread only: not settled (ready or failed) yet
+		string key;
+		list<Label *>::iterator lruPosition;
+		size_t bytes;			//	Surface memory once settled, texture memory once uploaded
+		Uint64 lastFrame;		//	Last frame the label was drawn in
+	} Label;
+
+	JobSystem * jobs;
+	string fontPath;
+	unordered_map<string, Label *> labels;
+	unordered_map<string, Label *> latestByText;	//	Last ready label for each (text, color), used as placeholder
+	int pendingCount;	//	Labels requested but not settled yet
+	vector<Label *> pendingLabels;
+	int jobsInFlight;	//	Render thread only
+	atomic<int> finishedJobs;	//	Bumped by workers, drained by the render thread
+	list<Label *> lru;	//	Most recently drawn first
+	size_t memoryBudget;
+	size_t memoryInUse;
+	Uint64 frame;
+	Uint64 evictions;
+	SdfFont sdf;
+	mutex fontsLock;
+	map<thread::id, TTF_Font *> fonts;
+	string lookupKey;	//	Render thread only, reused so lookups don't allocate
+	// Constructors
+public:
+	TextRasterizer();
+	~TextRasterizer();
+protected:
+private:
+	// Methods
+public:
+	__inline void SetJobSystem(JobSystem * jobSystem) { jobs = jobSystem; }
+	__inline void SetFontPath(const string & path) { fontPath = path; }
+	bool LoadSdfFont();
+	__inline bool IsSdfFontLoaded() const { return sdf.IsLoaded(); }
+	__inline void SetMemoryBudget(size_t bytes) { memoryBudget = bytes; }
+	__inline size_t GetMemoryBudget() const { return memoryBudget; }
+	__inline size_t GetMemoryInUse() const { return memoryInUse; }
+	__inline size_t GetLabelCount() const { return labels.size(); }
+	__inline Uint64 GetEvictions() const { return evictions; }
+	void NextFrame();
+	void PrintReport(ostream & out) const;
+	bool Draw(SDL_Renderer * r, const char * text, size_t length, int posX, int posY, const SDL_Color & color, int size);
+	bool Draw(SDL_Renderer * r, const TextRun & run, int posX, int posY);
+	__inline bool HasPendingLabels() const { return pendingCount > 0; }
+	void Shutdown();
+
+	static void MakeKey(const string & text, const SDL_Color & color, int size, string & key);
+	static void MakeKey(const char * text, size_t length, const SDL_Color & color, int size, string & key);
+protected:
+private:
+	bool Draw(SDL_Renderer * r, const string & key, const char * text, size_t length, int posX, int posY, const SDL_Color & color, int size);
+	TTF_Font * GetThreadFont(int size);
+	void Rasterize(Label * label);
+	void Settle(Label * label);
+	bool Upload(SDL_Renderer * r, Label * label);
+	void Evict();
+	void Destroy(Label * label);
+	void DrawTexture(SDL_Renderer * r, const Label * label, int posX, int posY, int w, int h) const;
+};
@@ -0,0 +1,34 @@
+#include "TextRun.h"
+
+#pragma region Game Includes
+#include "TextRasterizer.h"
+#pragma endregion
+
+TextRun::TextRun() :
+	color{0, 0, 0, 0},
+	size(0)
+{ }
+
+TextRun::TextRun(const string & runText, const SDL_Color & runColor, int runSize) :
+	color{0, 0, 0, 0},
+	size(0)
+{
+	Set(runText, runColor, runSize);
+}
+
+void TextRun::Set(const string & runText, const SDL_Color & runColor, int runSize)
+{
+	Set(runText.data(), runText.size(), runColor, runSize);
+}
+
+void TextRun::Set(const char * runText, size_t length, const SDL_Color & runColor, int runSize)
+{
+	const bool sameColor = color.r == runColor.r && color.g == runColor.g && color.b == runColor.b && color.a == runColor.a;
+	if(!key.empty() && size == runSize && sameColor && text.compare(0, string::npos, runText, length) == 0)
+		return;
+
+	text.assign(runText, length);
+	color = runColor;
+	size = runSize;
+	TextRasterizer::MakeKey(text, color, size, key);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+/*
+ * A label prepared once and drawn many times: text, color and
+ * size along with the cache key the rasterizer looks it up by.
+ * Drawing a run builds nothing, so it's the cheapest way to draw
+ * text that changes rarely (or never). Setting it again only
+ * rebuilds the key when something actually changed.
+ */
+class TextRun
+{
+	// Fields
+public:
+protected:
+private:
+	string text;
+	SDL_Color color;
+	int size;
+	string key;
+	// Constructors
+public:
+	TextRun();
+	TextRun(const string & runText, const SDL_Color & runColor, int runSize);
+protected:
+private:
+	// Methods
+public:
+	void Set(const string & runText, const SDL_Color & runColor, int runSize);
+	void Set(const char * runText, size_t length, const SDL_Color & runColor, int runSize);
+	__inline const string & GetText() const { return text; }
+	__inline const SDL_Color & GetColor() const { return color; }
+	__inline int GetSize() const { return size; }
+	__inline const string & GetKey() const { return key; }
+	__inline bool IsEmpty() const { return text.empty(); }
+protected:
+private:
+};
@@ -0,0 +1,246 @@
+#include "TimerWheel.h"
+
+#pragma region Timer
+Timer::Timer() :
+	Timer(nullptr, nullptr)
+{ }
+
+Timer::Timer(TimerCallback timerCallback, void * timerUserData) :
+	TimerLink{nullptr, nullptr},
+	callback(timerCallback),
+	userData(timerUserData),
+	wheel(nullptr),
+	due(0),
+	slot(-1)
+{ }
+
+Timer::~Timer()
+{
+	Cancel();
+}
+
+void Timer::Cancel()
+{
+	if(wheel)
+		wheel->Cancel(*this);
+}
+#pragma endregion
+
+#pragma region Timer Wheel
+//	Sentinel of an empty circular list
+static __inline void ResetList(TimerLink & list) { list.prev = list.next = &list; }
+
+//	Move all the links of a list into an empty one
+static __inline void MoveList(TimerLink & from, TimerLink & to)
+{
+	if(from.next == &from)
+	{
+		ResetList(to);
+		return;
+	}
+
+	to.next = from.next;
+	to.prev = from.prev;
+	to.next->prev = &to;
+	to.prev->next = &to;
+	ResetList(from);
+}
+
+TimerWheel::TimerWheel() :
+	occupancy{0},
+	current(0),
+	count(0)
+{
+	for(int l = 0; l < TIMER_WHEEL_LEVELS; l++)
+		for(int s = 0; s < TIMER_WHEEL_SLOTS; s++)
+			ResetList(slots[l][s]);
+}
+
+TimerWheel::~TimerWheel()
+{
+	//	Release the timers still scheduled, so they won't reach back to a dead wheel
+	for(int l = 0; l < TIMER_WHEEL_LEVELS; l++)
+		for(int s = 0; s < TIMER_WHEEL_SLOTS; s++)
+			while(slots[l][s].next != &slots[l][s])
+				Unlink(*static_cast<Timer *>(slots[l][s].next));
+}
+
+void TimerWheel::Schedule(Timer & timer, Uint64 dueTicks)
+{
+	//	Rescheduling simply moves the timer
+	if(timer.wheel)
+		Unlink(timer);
+
+	timer.wheel = this;
+	timer.due = dueTicks;
+	count++;
+	File(timer);
+}
+
+void TimerWheel::Cancel(Timer & timer)
+{
+	if(timer.wheel == this)
+		Unlink(timer);
+}
+
+void TimerWheel::Advance(Uint64 nowTicks)
+{
+	while(current < nowTicks)
+	{
+		//	Nothing to wait for, jump straight to the target
+		if(count == 0)
+		{
+			current = nowTicks;
+			break;
+		}
+
+		const Uint64 tick = current + 1;
+		const int index = (int)(tick & TIMER_WHEEL_SLOT_MASK);
+
+		//	No timers left in this turn of level 0: skip to the end of the turn (or to the target)
+		if(index != 0 && (occupancy[0] >> index) == 0)
+		{
+			const Uint64 turnEnd = tick | TIMER_WHEEL_SLOT_MASK;
+			current = turnEnd < nowTicks ? turnEnd : nowTicks;
+			continue;
+		}
+
+		//	Level 0 starts a new turn: refill it from the upper levels
+		if(index == 0)
+			for(int l = 1; l < TIMER_WHEEL_LEVELS; l++)
+			{
+				Cascade(l);
+				if(((tick >> (TIMER_WHEEL_SLOT_BITS * l)) & TIMER_WHEEL_SLOT_MASK) != 0)
+					break;
+			}
+
+		/*
+		 * Detach the expired slot before running callbacks and
+		 * move time forward, so timers scheduled by callbacks
+		 * (even already due) land in a later slot.
+		 */
+		TimerLink expired;
+		MoveList(slots[0][index], expired);
+		occupancy[0] &= ~((Uint64)1 << index);
+		current = tick;
+
+		for(TimerLink * link = expired.next; link != &expired; link = link->next)
+			static_cast<Timer *>(link)->slot = -1;
+
+		while(expired.next != &expired)
+		{
+			Timer & timer = *static_cast<Timer *>(expired.next);
+			Unlink(timer);
+			if(timer.callback)
+				timer.callback(timer.userData);
+		}
+	}
+}
+
+Uint64 TimerWheel::GetNextDue() const
+{
+	/*
+	 * A lower bound of the next timer due time, good to know
+	 * how long nothing will happen (never later than the real
+	 * one). Level 0 slots hold timers due exactly at their tick,
+	 * upper level slots give the start of the time they span.
+	 * The slot at the current position of an upper level may
+	 * hold timers not cascaded yet, so it bounds to right now.
+	 */
+	if(count == 0)
+		return (Uint64)-1;
+
+	const Uint64 base = current + 1;
+	Uint64 nextDue = (Uint64)-1;
+	for(int l = 0; l < TIMER_WHEEL_LEVELS; l++)
+	{
+		if(!occupancy[l])
+			continue;
+
+		const int shift = TIMER_WHEEL_SLOT_BITS * l;
+		const Uint64 position = base >> shift;
+		for(int d = 0; d < TIMER_WHEEL_SLOTS; d++)
+			if(occupancy[l] & ((Uint64)1 << ((position + d) & TIMER_WHEEL_SLOT_MASK)))
+			{
+				const Uint64 bound = d == 0 ? base : (position + d) << shift;
+				if(bound < nextDue)
+					nextDue = bound;
+				break;
+			}
+	}
+
+	return nextDue;
+}
+
+void TimerWheel::File(Timer & timer)
+{
+	/*
+	 * Pick the level by distance from the next tick to be
+	 * processed, and the slot by the due time bits of that
+	 * level. Past timers go in the very next slot, timers
+	 * beyond the wheel range wait in the farthest slot and
+	 * get filed again when it cascades.
+	 */
+	const Uint64 base = current + 1;
+	Uint64 due = timer.due < base ? base : timer.due;
+	if(due - base >= TIMER_WHEEL_RANGE)
+		due = base + TIMER_WHEEL_RANGE - 1;
+
+	const Uint64 delta = due - base;
+	int level = 0;
+	while(level < TIMER_WHEEL_LEVELS - 1 && delta >= ((Uint64)1 << (TIMER_WHEEL_SLOT_BITS * (level + 1))))
+		level++;
+	const int index = (int)((due >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK);
+
+	//	Append, so timers due at the same tick run in scheduling order
+	TimerLink & list = slots[level][index];
+	TimerLink & link = timer;
+	link.prev = list.prev;
+	link.next = &list;
+	list.prev->next = &link;
+	list.prev = &link;
+
+	timer.slot = level * TIMER_WHEEL_SLOTS + index;
+	occupancy[level] |= (Uint64)1 << index;
+}
+
+void TimerWheel::Unlink(Timer & timer)
+{
+	TimerLink & link = timer;
+	link.prev->next = link.next;
+	link.next->prev = link.prev;
+
+	//	Keep the occupancy bits in sync, unless the timer was already detached from its slot
+	if(timer.slot >= 0)
+	{
+		const int level = timer.slot / TIMER_WHEEL_SLOTS;
+		const int index = timer.slot % TIMER_WHEEL_SLOTS;
+		if(slots[level][index].next == &slots[level][index])
+			occupancy[level] &= ~((Uint64)1 << index);
+	}
+
+	link.prev = link.next = nullptr;
+	timer.slot = -1;
+	timer.wheel = nullptr;
+	count--;
+}
+
+void TimerWheel::Cascade(int level)
+{
+	//	Spread the upper level slot matching the tick about to be processed over the lower levels
+	const int index = (int)(((current + 1) >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK);
+
+	TimerLink pending;
+	MoveList(slots[level][index], pending);
+	occupancy[level] &= ~((Uint64)1 << index);
+
+	while(pending.next != &pending)
+	{
+		Timer & timer = *static_cast<Timer *>(pending.next);
+		TimerLink & link = timer;
+		link.prev->next = link.next;
+		link.next->prev = link.prev;
+		File(timer);
+	}
+}
+#pragma endregion
@@ -0,0 +1,116 @@
+#pragma once
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Wheel shape: each level has 64 slots, each slot of a level spans a whole lower level
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+//	Farthest delay (in ticks) the wheel can hold directly, farther timers are re-filed as time goes by
+#define TIMER_WHEEL_RANGE ((Uint64)1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS))
+#pragma endregion
+
+class TimerWheel;
+
+typedef void (*TimerCallback)(void * userData);
+
+/*
+ * Links of the intrusive lists held by the wheel slots.
+ */
+typedef struct TimerLink
+{
+	TimerLink * prev;
+	TimerLink * next;
+} TimerLink;
+
+/*
+ * A callback to be run at a given time.
+ * Timers are owned by whoever schedules them (typically as
+ * a member field): the wheel only links them in its slots,
+ * so scheduling and cancelling never allocate.
+ * A timer going out of scope cancels itself.
+ */
+class Timer : private TimerLink
+{
+	// Fields
+public:
+protected:
+private:
+	TimerCallback callback;
+	void * userData;
+	TimerWheel * wheel;	//	Set while scheduled
+	Uint64 due;
+	int slot;			//	Level and slot index, to keep the slot occupancy up to date
+	// Constructors
+public:
+	Timer();
+	Timer(TimerCallback timerCallback, void * timerUserData);
+	~Timer();
+	//	Timers are linked by address, copying one would corrupt the wheel
+	Timer(const Timer &) = delete;
+	Timer & operator=(const Timer &) = delete;
+protected:
+private:
+	// Methods
+public:
+	__inline void SetCallback(TimerCallback timerCallback, void * timerUserData) { callback = timerCallback; userData = timerUserData; }
+	__inline bool IsScheduled() const { return wheel != nullptr; }
+	__inline Uint64 GetDue() const { return due; }
+	void Cancel();
+protected:
+private:
+
+	friend class TimerWheel;
+};
+
+/*
+ * A hierarchical timer wheel running callbacks at future
+ * frame clock times.
+ * Level 0 has a slot per tick (millisecond), each upper level
+ * has slots spanning the whole level below. Timers are filed
+ * in the level matching how far in the future they are and,
+ * every time a lower level completes a turn, the next slot of
+ * the upper level is spread into it. Scheduling and cancelling
+ * are O(1), advancing costs a slot visit per elapsed tick and
+ * skips ahead when no timer is pending.
+ * Callbacks run on the thread calling Advance and may
+ * schedule or cancel any timer, including their own.
+ */
+class TimerWheel
+{
+	// Fields
+public:
+protected:
+private:
+	TimerLink slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];	//	List sentinels
+	Uint64 occupancy[TIMER_WHEEL_LEVELS];					//	A bit per non-empty slot
+	Uint64 current;		//	Last processed tick, timers due up to here already ran
+	int count;
+	// Constructors
+public:
+	TimerWheel();
+	~TimerWheel();
+	TimerWheel(const TimerWheel &) = delete;
+	TimerWheel & operator=(const TimerWheel &) = delete;
+protected:
+private:
+	// Methods
+public:
+	void Schedule(Timer & timer, Uint64 dueTicks);
+	__inline void ScheduleIn(Timer & timer, Uint64 delayTicks) { Schedule(timer, GetNow() + delayTicks); }
+	void Cancel(Timer & timer);
+	void Advance(Uint64 nowTicks);
+	__inline Uint64 GetNow() const { return current; }
+	__inline int GetCount() const { return count; }
+	Uint64 GetNextDue() const;
+protected:
+private:
+	void File(Timer & timer);
+	void Unlink(Timer & timer);
+	void Cascade(int level);
+};
@@ -0,0 +1,208 @@
+#include "TraceLog.h"
+
+#pragma region C++ Includes
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#pragma endregion
+
+//	Zones go to this log, when one is set (read from any thread)
+static atomic<TraceLog *> traceLog(nullptr);
+
+//	Each thread finds its own buffer here, once registered
+static thread_local void * threadBuffer = nullptr;
+
+/*
+ * Zone timestamps, in nanoseconds. The standard steady clock
+ * keeps the log (and the job system tracing through it) free
+ * from the SDL runtime, so tools can link it.
+ */
+static Uint64 GetTraceTicks()
+{
+	return (Uint64)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TraceLog::TraceLog() :
+	origin(0),
+	ticksToMicroseconds(0.0),
+	firstEvent(true),
+	stopping(false),
+	running(false)
+{ }
+
+TraceLog::~TraceLog()
+{
+	Stop();
+
+	for(ThreadBuffer * buffer : buffers)
+		delete buffer;
+}
+
+bool TraceLog::Start(const string & path)
+{
+	if(running)
+		return false;
+
+	file.open(path, ios::out | ios::trunc);
+	if(!file)
+		return false;
+
+	origin = GetTraceTicks();
+	ticksToMicroseconds = 0.001;
+	firstEvent = true;
+	file << fixed << setprecision(3);
+	file << "{\"traceEvents\":[";
+
+	stopping = false;
+	running = true;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	//	No threads to write on: everything gets written on Stop
+#else
+	writer = thread(&TraceLog::WriterLoop, this);
+#endif
+	return true;
+}
+
+void TraceLog::Stop()
+{
+	//	Callers unregister the log first: no zone may be recorded during (or after) the last flush
+	if(!running)
+		return;
+
+	{
+		lock_guard<mutex> lock(writerLock);
+		stopping = true;
+	}
+	wake.notify_one();
+	if(writer.joinable())
+		writer.join();
+
+	//	Whatever is left, then the thread names
+	Flush();
+	lock_guard<mutex> lock(buffersLock);
+	for(ThreadBuffer * buffer : buffers)
+	{
+		if(!buffer->threadName)
+			continue;
+		file << (firstEvent ? "\n" : ",\n");
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex;
+		file << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+		firstEvent = false;
+	}
+	file << "\n]}" << endl;
+	file.close();
+	running = false;
+}
+
+void TraceLog::Record(const char * name, Uint64 begin, Uint64 end)
+{
+	ThreadBuffer * buffer = GetThreadBuffer();
+	lock_guard<mutex> lock(buffer->lock);
+	buffer->zones.push_back(Zone{name, begin, end});
+}
+
+void TraceLog::NameCurrentThread(const char * name)
+{
+	ThreadBuffer * buffer = GetThreadBuffer();
+	lock_guard<mutex> lock(buffer->lock);
+	buffer->threadName = name;
+}
+
+TraceLog::ThreadBuffer * TraceLog::GetThreadBuffer()
+{
+	//	First zone on this thread: register a buffer for it
+	if(!threadBuffer)
+	{
+		ThreadBuffer * buffer = new ThreadBuffer();
+		buffer->threadName = nullptr;
+
+		lock_guard<mutex> lock(buffersLock);
+		buffer->threadIndex = (int)buffers.size();
+		buffers.push_back(buffer);
+		threadBuffer = buffer;
+	}
+
+	return (ThreadBuffer *)threadBuffer;
+}
+
+void TraceLog::WriterLoop()
+{
+	unique_lock<mutex> lock(writerLock);
+	while(!stopping)
+	{
+		wake.wait_for(lock, chrono::milliseconds(TRACE_FLUSH_INTERVAL));
+		if(stopping)
+			break;
+
+		lock.unlock();
+		Flush();
+		lock.lock();
+	}
+}
+
+void TraceLog::Flush()
+{
+	/*
+	 * Take the list of buffers under the lock, then swap each
+	 * buffer with its spare under that buffer's lock only: the
+	 * owner thread is blocked for a pointer swap, threads tracing
+	 * their first zone don't wait for the disk, and formatting
+	 * and writing hold nothing.
+	 * Buffers are never removed before the log is destroyed.
+	 */
+	{
+		lock_guard<mutex> lock(buffersLock);
+		flushing = buffers;
+	}
+
+	for(ThreadBuffer * buffer : flushing)
+	{
+		{
+			lock_guard<mutex> bufferLock(buffer->lock);
+			buffer->zones.swap(buffer->spare);
+		}
+
+		for(const Zone & zone : buffer->spare)
+		{
+			file << (firstEvent ? "\n" : ",\n");
+			file << "{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadIndex;
+			file << ",\"ts\":" << (zone.begin - origin) * ticksToMicroseconds;
+			file << ",\"dur\":" << (zone.end - zone.begin) * ticksToMicroseconds << "}";
+			firstEvent = false;
+		}
+
+		//	Empty again, with its capacity, for the owner thread to fill after the next swap
+		buffer->spare.clear();
+	}
+	file.flush();
+}
+
+TraceZone::TraceZone(const char * zoneName) :
+	log(traceLog.load(memory_order_acquire)),
+	name(zoneName),
+	begin(log ? GetTraceTicks() : 0)
+{ }
+
+TraceZone::~TraceZone()
+{
+	End();
+}
+
+void TraceZone::End()
+{
+	if(!log)
+		return;
+
+	log->Record(name, begin, GetTraceTicks());
+	log = nullptr;
+}
+
+void SetTraceLog(TraceLog * log)
+{
+	traceLog.store(log, memory_order_release);
+}
+
+TraceLog * GetTraceLog()
+{
+	return traceLog.load(memory_order_acquire);
+}
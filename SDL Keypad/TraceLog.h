@@ -0,0 +1,133 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	How often the background thread writes buffered zones to the file
+#define TRACE_FLUSH_INTERVAL 100
+#pragma endregion
+
+/*
+ * Records scoped zones (frame phases, renders, labels, event
+ * dispatches, jobs...) to a Chrome trace-event JSON file, to be
+ * opened in chrome://tracing or Perfetto and see exactly what a
+ * slow frame spent its time on.
+ * Every thread appends its zones to its own buffer, so threads
+ * never wait for each other (the buffer lock is only shared
+ * with the writer, a few times per second). A background thread
+ * periodically takes the buffers and writes them out, keeping
+ * file I/O off the frame.
+ * Zone names must be string literals (or live as long as the
+ * log does): only the pointer is kept.
+ * A log records one session, from Start to Stop.
+ */
+class TraceLog
+{
+	// Fields
+public:
+protected:
+private:
+	typedef struct
+	{
+		const char * name;
+		Uint64 begin;	//	Steady clock nanoseconds
+		Uint64 end;
+	} Zone;
+
+	typedef struct
+	{
+		mutex lock;
+		vector<Zone> zones;
+		vector<Zone> spare;		//	Writer only: swapped with zones on each flush, so both keep their capacity
+		int threadIndex;
+		const char * threadName;
+	} ThreadBuffer;
+
+	ofstream file;
+	Uint64 origin;
+	double ticksToMicroseconds;
+	bool firstEvent;
+	mutex buffersLock;
+	vector<ThreadBuffer *> buffers;
+	vector<ThreadBuffer *> flushing;	//	Writer only: the buffers of the current flush
+	thread writer;
+	mutex writerLock;
+	condition_variable wake;
+	bool stopping;
+	bool running;
+	// Constructors
+public:
+	TraceLog();
+	~TraceLog();
+	TraceLog(const TraceLog &) = delete;
+	TraceLog & operator=(const TraceLog &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Start(const string & path);
+	void Stop();
+	__inline bool IsRunning() const { return running; }
+	void Record(const char * name, Uint64 begin, Uint64 end);
+	void NameCurrentThread(const char * name);
+protected:
+private:
+	ThreadBuffer * GetThreadBuffer();
+	void WriterLoop();
+	void Flush();
+};
+
+/*
+ * Measures the time between its construction and End() (or its
+ * destruction) and records it as a zone, when a trace log is
+ * registered. Costs an atomic load and a branch otherwise.
+ */
+class TraceZone
+{
+	// Fields
+public:
+protected:
+private:
+	TraceLog * log;
+	const char * name;
+	Uint64 begin;
+	// Constructors
+public:
+	TraceZone(const char * zoneName);
+	~TraceZone();
+	TraceZone(const TraceZone &) = delete;
+	TraceZone & operator=(const TraceZone &) = delete;
+protected:
+private:
+	// Methods
+public:
+	void End();
+protected:
+private:
+};
+
+//	Traces the rest of the current scope
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+
+/*
+ * Code being traced doesn't know the engine, zones go to the
+ * log registered here, if any.
+ */
+void SetTraceLog(TraceLog * log);
+TraceLog * GetTraceLog();
@@ -15,20 +15,26 @@
 #include <SDL_ttf.h>
 #pragma endregion
 
+#pragma region Game Includes
+#include "TextRasterizer.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
+#pragma endregion
+
 #ifdef _WIN32
 #define PATH_SEPARATOR '\\'
 #else
 #define PATH_SEPARATOR '/'
 #endif
 
+//	Labels go through this rasterizer, when one is set
+static TextRasterizer * textRasterizer = nullptr;
+
 /*
- * This is a very much inefficient way to render
- * a label. It was intentionally done this way
- * for simplicity and to make the process clearer.
+ * Full path of the font resource, next to the executable.
  */
-void RenderLabel(SDL_Renderer * r, string text, int posX, int posY, const SDL_Color & color, int size)
+string GetFontPath()
 {
-	// Load font
 	ostringstream fontFullPath;
 	fontFullPath << SDL_GetBasePath() << PATH_SEPARATOR;
 	fontFullPath << "res" << PATH_SEPARATOR;
@@ -42,7 +48,47 @@ void RenderLabel(SDL_Renderer * r, string text, int posX, int posY, const SDL_Co
 #endif
 	*/
 
-	TTF_Font * font = TTF_OpenFont(fontFullPath.str().c_str(), size);
+	return fontFullPath.str();
+}
+
+/*
+ * Routes all the following RenderLabel calls through a
+ * rasterizer that caches labels and builds them on worker
+ * threads. Pass nullptr to go back to the direct path.
+ */
+void SetTextRasterizer(TextRasterizer * rasterizer)
+{
+	textRasterizer = rasterizer;
+}
+
+/*
+ * Draws a label centered on the given position.
+ * Returns false when only a placeholder was drawn, because
+ * the label is still being rasterized.
+ */
+bool RenderLabel(SDL_Renderer * r, const string & text, int posX, int posY, const SDL_Color & color, int size)
+{
+	return RenderLabel(r, text.data(), text.size(), posX, posY, color, size);
+}
+
+/*
+ * Same, for a span of UTF-8 text that doesn't need to be a
+ * string (nor to be null-terminated): a slice of a charset,
+ * a literal...
+ * Without a TextRasterizer set, this is a very much
+ * inefficient way to render a label. It was intentionally
+ * done this way for simplicity and to make the process
+ * clearer. Once a TextRasterizer is set, it takes over.
+ */
+bool RenderLabel(SDL_Renderer * r, const char * text, size_t length, int posX, int posY, const SDL_Color & color, int size)
+{
+	TRACE_SCOPE("RenderLabel");
+
+	if(textRasterizer)
+		return textRasterizer->Draw(r, text, length, posX, posY, color, size);
+
+	// Load font
+	TTF_Font * font = StatsOpenFont(GetFontPath().c_str(), size);
 	if(!font)
 	{
 		/*
@@ -52,14 +98,14 @@ void RenderLabel(SDL_Renderer * r, string text, int posX, int posY, const SDL_Co
 		 */
 		SDL_Rect missingFontArea{posX - size / 2, posY - size / 2, size, size};
 		SDL_SetRenderDrawColor(r, color.r, color.g, color.b, color.a);
-		SDL_RenderDrawRect(r, &missingFontArea);
+		StatsRenderDrawRect(r, &missingFontArea);
 
-		return;
+		return true;
 	}
 
 	// Render text
-	SDL_Surface * surf = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-	SDL_Texture * texture = SDL_CreateTextureFromSurface(r, surf);
+	SDL_Surface * surf = TTF_RenderUTF8_Blended(font, string(text, length).c_str(), color);
+	SDL_Texture * texture = StatsCreateTextureFromSurface(r, surf);
 
 	// Calculate target portion
 	SDL_Rect target;
@@ -69,12 +115,39 @@ void RenderLabel(SDL_Renderer * r, string text, int posX, int posY, const SDL_Co
 	target.y = posY - target.h / 2;
 
 	// Copy to render target
-	SDL_RenderCopy(r, texture, nullptr, &target);
+	StatsRenderCopy(r, texture, nullptr, &target);
 
 	// Cleanup
 	SDL_DestroyTexture(texture);
 	SDL_FreeSurface(surf);
 	TTF_CloseFont(font);
+
+	return true;
+}
+
+/*
+ * Same, for a single character, given by its code point.
+ */
+bool RenderLabel(SDL_Renderer * r, Uint32 codePoint, int posX, int posY, const SDL_Color & color, int size)
+{
+	char utf8[4];
+	const size_t length = Charset::EncodeUtf8(codePoint, utf8);
+	return RenderLabel(r, utf8, length, posX, posY, color, size);
+}
+
+/*
+ * Same, for a run prepared beforehand: nothing gets built
+ * to draw it.
+ */
+bool RenderLabel(SDL_Renderer * r, const TextRun & run, int posX, int posY)
+{
+	if(textRasterizer)
+	{
+		TRACE_SCOPE("RenderLabel");
+		return textRasterizer->Draw(r, run, posX, posY);
+	}
+
+	return RenderLabel(r, run.GetText(), posX, posY, run.GetColor(), run.GetSize());
 }
 
 /*
@@ -101,12 +174,12 @@ int GetRandomNumber(const int minInclusive, const int maxExclusive)
  * This funciton uses a charset and the GetRandomIndex function
  * to build a random code of a given length.
  */
-string GetRandomCode(const string & charset, const int length)
+Code GetRandomCode(const Charset & charset, const int length)
 {
-	ostringstream codeStream;
+	Code code(length);
 
 	for(int c = 0; c < length; c++)
-		codeStream << charset[GetRandomIndex((int)charset.size())];
+		code[c] = (CharIndex)GetRandomIndex(charset.GetLength());
 
-	return codeStream.str();
+	return code;
 }
@@ -9,8 +9,15 @@
 #include <SDL.h>
 #pragma endregion
 
+#pragma region Game Includes
+#include "Charset.h"
+#pragma endregion
+
 using namespace std;
 
+class TextRasterizer;
+class TextRun;
+
 #pragma region Constant Parameters
 //	Font resource
 #define FONT "digital-7.ttf"
@@ -22,8 +29,13 @@ using namespace std;
  * This file contains only forward declarations.
  */
 
-void RenderLabel(SDL_Renderer * r, string text, int posX, int posY, const SDL_Color & color, int size = 24);
+string GetFontPath();
+void SetTextRasterizer(TextRasterizer * rasterizer);
+bool RenderLabel(SDL_Renderer * r, const string & text, int posX, int posY, const SDL_Color & color, int size = 24);
+bool RenderLabel(SDL_Renderer * r, const char * text, size_t length, int posX, int posY, const SDL_Color & color, int size = 24);
+bool RenderLabel(SDL_Renderer * r, Uint32 codePoint, int posX, int posY, const SDL_Color & color, int size = 24);
+bool RenderLabel(SDL_Renderer * r, const TextRun & run, int posX, int posY);
 int GetRandomNumber(const int minInclusive, const int maxExclusive);
 __inline int GetRandomIndex(const int length) { return GetRandomNumber(0, length); }
-string GetRandomCode(const string & charset, const int lenght);
+Code GetRandomCode(const Charset & charset, const int lenght);
 
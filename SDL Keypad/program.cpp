@@ -1,7 +1,9 @@
 #pragma region C++ Includes
 #include <iostream>
-#include <chrono>
 #include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
 #pragma endregion
 
 #pragma region SDL Includes
@@ -18,8 +20,30 @@
 #include "IInteractable.h"
 #include "IRenderable.h"
 
+//	Engine services
+#include "FrameClock.h"
+#include "FramePacer.h"
+#include "JobSystem.h"
+#include "PhaseScheduler.h"
+#include "TextRasterizer.h"
+#include "TimerWheel.h"
+#include "LayerCache.h"
+#include "LatencyTracker.h"
+#include "ResizeDebouncer.h"
+#include "RenderStats.h"
+#include "TraceLog.h"
+#include "StatePublisher.h"
+#include "TelemetryLog.h"
+
+//	Shared helpers
+#include "Utilities.h"
+
 //	Game elements
 #include "LockpickingGame.h"
+
+//	Debug overlays
+#include "LatencyOverlay.h"
+#include "StatsOverlay.h"
 #pragma endregion
 
 #pragma region Emscripten Includes
@@ -30,7 +54,6 @@
 #pragma endregion
 
 using namespace std;
-using namespace std::chrono;
 
 #pragma region Docs Links
 /*
@@ -71,12 +94,22 @@ using namespace std::chrono;
 #define HTML_CANVAS_SELECTOR "#canvas"
 #endif
 
-//	The fixed time step we aim to
+//	The fixed time step we aim to (when not synced to the display)
 #define TARGET_FPS 60
-#define TARGET_FRAME_TIME 1000 / TARGET_FPS
+
+//	Idle mode: shortest wait worth blocking for, and longest wait without a check
+#define IDLE_MIN_TIMEOUT (1000 / TARGET_FPS)
+#define IDLE_MAX_TIMEOUT 1000
 
 //	Color palette
 #define COL_CLEAR 32, 32, 32, 255
+
+//	Late latch: max pending motion events looked at before rendering
+#define LATE_LATCH_MAX_EVENTS 64
+
+//	Benchmark synthetic drag: radius (relative to the shortest window side) and angle per frame
+#define BENCHMARK_DRAG_RADIUS_RATIO 0.3f
+#define BENCHMARK_DRAG_STEP 0.05f
 #pragma endregion
 
 #pragma region Exchange data
@@ -88,6 +121,20 @@ using namespace std::chrono;
  * program or simply made global.
  */
 typedef struct
+{
+	float benchmarkSeconds;		//	When > 0, run a synthetic drag for this long, then quit and print a report
+	bool latencyOverlay;
+	bool statsOverlay;
+	bool lateLatch;				//	Apply the freshest pointer motion right before rendering
+	PresentMode presentMode;
+	bool idle;					//	Block on events while nothing on screen would change
+	float labelBudgetMegabytes;	//	Texture memory for cached labels
+	string tracePath;			//	When set, record a trace of the whole run to this file
+	bool sdfText;				//	Compose labels from a distance field atlas instead of FreeType
+	bool shareState;			//	Publish the game state to shared memory for external overlays
+	string telemetryPath;		//	When set, append gameplay events to this file
+} LaunchOptions;
+typedef struct
 {
 	SDL_Window * window;
 	SDL_Renderer * r;
@@ -95,7 +142,18 @@ typedef struct
 typedef struct
 {
 	bool closeRequested;
-	vector<ILifecycle *> lifecycleQueue;
+	Uint32 idleTimeout;		//	Real milliseconds the next frame may wait for events before running
+	FrameClock clock;
+	FramePacer pacer;
+	TimerWheel timers;
+	LatencyTracker latency;
+	JobSystem jobs;
+	PhaseScheduler scheduler;
+	TextRasterizer text;
+	ResizeDebouncer resize;
+	TraceLog trace;
+	StatePublisher publisher;
+	TelemetryLog telemetry;
 	vector<IInteractable *> interactionQueue;
 	vector<IRenderable const *> renderQueue;
 } EngineData;
@@ -106,16 +164,36 @@ typedef struct
 } GameData;
 typedef struct
 {
+	LatencyOverlay latencyOverlay;
+	StatsOverlay statsOverlay;
+} DebugData;
+typedef struct
+{
+	Uint64 startTicks;
+	Uint64 frames;
+	float dragAngle;
+} BenchmarkData;
+typedef struct
+{
+	LaunchOptions options;
 	SystemData system;
 	EngineData engine;
 	GameData game;
+	DebugData debug;
+	BenchmarkData benchmark;
 } Context;
 #pragma endregion
 
 //	Forward declarations
+void ParseOptions(int argc, char * argv[]);
 void MainLoop();
 int SystemSetup();
 void SystemShutdown();
+Uint32 GetIdleTimeout();
+void LatchPointer();
+void PushBenchmarkInput();
+void PrintBenchmarkReport();
+const char * GetEventTraceName(Uint32 type);
 
 //	Prepare a global context for the main loop and the main function
 Context ctx;
@@ -130,6 +208,7 @@ int main(int argc, char * argv[])
 	 * work, such as SDL itself, font support, the
 	 * game window and the renderer.
 	 */
+	ParseOptions(argc, argv);
 	int systemStatus = SystemSetup();
 	if(systemStatus != 0)
 		return systemStatus;
@@ -139,13 +218,39 @@ int main(int argc, char * argv[])
 	//	Initialize game context
 	ctx.game.lockpickingGameArea = {0, 0, VIEWPORT_W, VIEWPORT_H};
 	ctx.game.lockpickingGame.SetViewportArea(ctx.game.lockpickingGameArea);
+	ctx.game.lockpickingGame.SetClock(ctx.engine.clock);
+	ctx.game.lockpickingGame.SetTimerWheel(ctx.engine.timers);
+	if(ctx.engine.telemetry.IsRunning())
+		ctx.game.lockpickingGame.SetTelemetryLog(ctx.engine.telemetry);
 
 	ctx.engine.closeRequested = false;
-
-	//	Fill lists for input, update and rendering
-	ctx.engine.lifecycleQueue.push_back(&ctx.game.lockpickingGame);
+	ctx.engine.idleTimeout = 0;
+
+	//	Measure input latency
+	SetLatencyTracker(&ctx.engine.latency);
+	ctx.debug.latencyOverlay.SetViewportArea(ctx.game.lockpickingGameArea);
+	ctx.debug.latencyOverlay.SetTracker(ctx.engine.latency);
+	ctx.debug.latencyOverlay.SetVisible(ctx.options.latencyOverlay);
+
+	//	Count draw calls, uploads, font opens and allocations while the stats overlay is up
+	ctx.debug.statsOverlay.SetViewportArea(ctx.game.lockpickingGameArea);
+	ctx.debug.statsOverlay.SetVisible(ctx.options.statsOverlay);
+
+	//	Register lifecycle systems and fill lists for input and rendering
+	ctx.engine.scheduler.AddLifecycle(
+		&ctx.game.lockpickingGame, "LockpickingGame",
+		RESOURCE_CLOCK | RESOURCE_INPUT,
+		RESOURCE_LAYOUT | RESOURCE_GAME
+	);
 	ctx.engine.interactionQueue.push_back(&ctx.game.lockpickingGame);
 	ctx.engine.renderQueue.push_back(&ctx.game.lockpickingGame);
+	ctx.engine.renderQueue.push_back(&ctx.debug.latencyOverlay);
+	ctx.engine.renderQueue.push_back(&ctx.debug.statsOverlay);
+
+	//	Benchmark runs start counting from the first frame
+	ctx.benchmark.startTicks = SDL_GetTicks64();
+	ctx.benchmark.frames = 0;
+	ctx.benchmark.dragAngle = 0.0f;
 #pragma endregion
 
 #pragma region Main Loop
@@ -186,6 +291,67 @@ int main(int argc, char * argv[])
 	return 0;
 }
 
+void ParseOptions(int argc, char * argv[])
+{
+	/*
+	 * Command line options:
+	 *	--benchmark <seconds>	drag the keypad wheel with synthetic input, then quit and print a report
+	 *	--latency-overlay		show input latency percentiles on screen (F2 toggles it anyway)
+	 *	--stats					show runtime stats and the frame time graph on screen (F3 toggles it anyway)
+	 *	--late-latch			re-sample the pointer right before rendering
+	 *	--present <mode>		vsync, sleep (default), busy, uncapped or adaptive
+	 *	--no-idle				keep redrawing every frame even when nothing changes
+	 *	--label-budget <MB>		texture memory for cached labels, least recently used ones go first
+	 *	--no-sdf				rasterize every label size with FreeType instead of the distance field atlas
+	 *	--trace <file>			write a Chrome trace-event JSON of frame phases, renders, labels and events
+	 *	--share-state			publish the game state to POSIX shared memory each frame, for stream overlays
+	 *	--telemetry <file>		append every submission, stage and game outcome to a binary event log
+	 */
+	ctx.options.benchmarkSeconds = 0.0f;
+	ctx.options.latencyOverlay = false;
+	ctx.options.statsOverlay = false;
+	ctx.options.lateLatch = false;
+	ctx.options.presentMode = PRESENT_SLEEP;
+	ctx.options.idle = true;
+	ctx.options.labelBudgetMegabytes = TEXT_CACHE_DEFAULT_BUDGET / (1024.0f * 1024.0f);
+	ctx.options.sdfText = true;
+	ctx.options.tracePath.clear();
+	ctx.options.shareState = false;
+	ctx.options.telemetryPath.clear();
+
+	for(int a = 1; a < argc; a++)
+	{
+		const string arg = argv[a];
+		if(arg == "--benchmark" && a + 1 < argc)
+			ctx.options.benchmarkSeconds = (float)atof(argv[++a]);
+		else if(arg == "--latency-overlay")
+			ctx.options.latencyOverlay = true;
+		else if(arg == "--stats")
+			ctx.options.statsOverlay = true;
+		else if(arg == "--late-latch")
+			ctx.options.lateLatch = true;
+		else if(arg == "--present" && a + 1 < argc)
+		{
+			if(!FramePacer::ParseMode(argv[++a], ctx.options.presentMode))
+				cout << "Unknown present mode: " << argv[a] << endl;
+		}
+		else if(arg == "--no-idle")
+			ctx.options.idle = false;
+		else if(arg == "--label-budget" && a + 1 < argc)
+			ctx.options.labelBudgetMegabytes = (float)atof(argv[++a]);
+		else if(arg == "--no-sdf")
+			ctx.options.sdfText = false;
+		else if(arg == "--trace" && a + 1 < argc)
+			ctx.options.tracePath = argv[++a];
+		else if(arg == "--share-state")
+			ctx.options.shareState = true;
+		else if(arg == "--telemetry" && a + 1 < argc)
+			ctx.options.telemetryPath = argv[++a];
+		else
+			cout << "Ignoring unknown option: " << arg << endl;
+	}
+}
+
 int SystemSetup()
 {
 	/*
@@ -235,19 +401,24 @@ int SystemSetup()
 		return 1;
 	}
 
+	//	Choose the presentation policy before the renderer gets created, it may need vsync from the start
+	ctx.engine.pacer.SetMode(ctx.options.presentMode);
+	ctx.engine.pacer.SetTargetFps(TARGET_FPS);
+
 	//	Get or create a rendeer for future render operations
 	ctx.system.r = SDL_GetRenderer(ctx.system.window);
 	if(!ctx.system.r)
 	{
 		cout << "Couldn't get SDL renderer from window: " << SDL_GetError() << endl;
 		cout << "Trying to create a new renderer.." << endl;
-		ctx.system.r = SDL_CreateRenderer(ctx.system.window, -1, SDL_RendererFlags::SDL_RENDERER_ACCELERATED);
+		ctx.system.r = SDL_CreateRenderer(ctx.system.window, -1, ctx.engine.pacer.GetRendererFlags());
 		if(!ctx.system.r)
 		{
 			cout << "Couldn't create SDL renderer on window: " << SDL_GetError() << endl;
 			return -1;
 		}
 	}
+	ctx.engine.pacer.Attach(ctx.system.window, ctx.system.r);
 
 	//	Initialize the TTF module
 	if(TTF_Init() != 0)
@@ -257,6 +428,40 @@ int SystemSetup()
 		cout << "SDL_ttf intialized succesfully!" << endl;
 #endif
 
+	//	Start tracing before any thread starts, so workers get named too
+	if(!ctx.options.tracePath.empty())
+	{
+		if(ctx.engine.trace.Start(ctx.options.tracePath))
+		{
+			SetTraceLog(&ctx.engine.trace);
+			ctx.engine.trace.NameCurrentThread("Main Thread");
+		}
+		else
+			cout << "Cannot write the trace to " << ctx.options.tracePath << endl;
+	}
+
+	//	Start the job system workers (leaving one core to the main thread) and let the scheduler use them
+	ctx.engine.jobs.Start(SDL_max(SDL_GetCPUCount() - 1, 0));
+	ctx.engine.scheduler.SetJobSystem(&ctx.engine.jobs);
+
+	//	Rasterize labels on the workers, the render thread only uploads and draws them
+	ctx.engine.text.SetJobSystem(&ctx.engine.jobs);
+	ctx.engine.text.SetFontPath(GetFontPath());
+	ctx.engine.text.SetMemoryBudget((size_t)(ctx.options.labelBudgetMegabytes * 1024.0f * 1024.0f));
+	SetTextRasterizer(&ctx.engine.text);
+
+	//	Build the distance field atlas once, so resizing never needs FreeType again
+	if(ctx.options.sdfText && !ctx.engine.text.LoadSdfFont())
+		cout << "Cannot build the distance field atlas, labels will use FreeType: " << TTF_GetError() << endl;
+
+	//	Open the shared state segment for external overlays
+	if(ctx.options.shareState && !ctx.engine.publisher.Open())
+		cout << "Cannot publish the game state to shared memory (POSIX only)" << endl;
+
+	//	Gameplay events are written by a background thread, the game only fills a ring
+	if(!ctx.options.telemetryPath.empty() && !ctx.engine.telemetry.Start(ctx.options.telemetryPath))
+		cout << "Cannot write the telemetry to " << ctx.options.telemetryPath << endl;
+
 	return 0;
 }
 
@@ -280,7 +485,9 @@ void MainLoop()
 	 * - Lifecycle Hooks: called at specific stages
 	 * Specific implementations can hook by implementing
 	 * specific interfaces and pushing themselves into
-	 * the dedicated lists.
+	 * the dedicated lists (lifecycle hooks are registered
+	 * to the phase scheduler, only for the phases they
+	 * actually implement).
 	 * This is far from a real wolrd engine implementation
 	 * both for performance and for the simple fact
 	 * that game implementation must be instantiated
@@ -288,9 +495,39 @@ void MainLoop()
 	 * similar to a real engine.
 	 */
 #pragma region Frame Start
-		//	LIFECYCLE: Broadcast frame-start event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnFrameStart();
+	/*
+	 * When nothing on screen would change, don't spin:
+	 * block until an event comes (input wakes us right
+	 * away) or until the next thing is due to move.
+	 * Events are left in the queue for the events loop.
+	 * The browser drives webgl builds, so no blocking there.
+	 */
+#ifndef __EMSCRIPTEN__
+	if(ctx.engine.idleTimeout > 0 && !SDL_HasEvents(SDL_FIRSTEVENT, SDL_LASTEVENT))
+	{
+		TRACE_SCOPE("Idle Wait");
+		SDL_WaitEventTimeout(nullptr, (int)ctx.engine.idleTimeout);
+		ctx.engine.pacer.OnIdle();
+	}
+#endif
+
+	//	Trace zones cover each region of the frame, and the frame as a whole
+	TraceZone frameZone("Frame");
+	TraceZone frameStartZone("Frame Start");
+
+	/*
+	 * Sample the frame clock once: every element reads the
+	 * time from this snapshot for the whole frame, so input,
+	 * logic and render all agree on whether time ran out.
+	 */
+	ctx.engine.clock.Sample();
+
+	//	Run the timers that came due, before anything else looks at this frame
+	ctx.engine.timers.Advance(ctx.engine.clock.GetTicks());
+
+		//	LIFECYCLE: Run frame-start phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::FrameStart);
+	frameStartZone.End();
 #pragma endregion
 
 #pragma region Prepare FPS Regulation
@@ -300,48 +537,61 @@ void MainLoop()
 	 * calculations and render and then wait for the
 	 * target frame time.
 	 * To do so, when the frame starts, i.e. when
-	 * entering the main loop, we store the precise
-	 * time.
-	 * 
-	 * When building for webgl, we let the browser decide
-	 * the frame rate, which will typically match the
-	 * monitor's refresh rate, so we're skipping all the
-	 * framerate regulation stuff when targetting webgl.
+	 * entering the main loop, the pacer stores the
+	 * precise time.
 	 */
-#ifndef __EMSCRIPTEN__
-	steady_clock::time_point frameStart = high_resolution_clock::now();
-#endif
+	ctx.engine.pacer.BeginFrame();
 #pragma endregion
 
 #pragma region Frame initialization
+	TraceZone frameInitializationZone("Frame Initialization");
+
 	// Get viewport size
 	/*
-	 * This part is highly inefficient. There's no need at
-	 * all to recalculate viewport size and all the screen
-	 * layout every frame as the game window doesn't cahgne
-	 * every frame.
-	 * In debug configuration, the window has been initialized
-	 * as resizable so we can play with the window and see
-	 * that the game contents do adapt.
-	 * In a real world scenario, all those calculations should
-	 * be done only when the viewport size actually changes.
+	 * In debug configuration (and on webgl), the window is
+	 * resizable so we can play with the window and see that
+	 * the game contents do adapt.
+	 * While the window is being resized, though, the layout
+	 * keeps the last stable size and the renderer scales it
+	 * to the window (SDL maps input events back to it), so
+	 * labels and layers aren't rebuilt for every intermediate
+	 * size. The layout follows once the size holds still.
 	 */
-	SDL_GetWindowSize(ctx.system.window, &ctx.game.lockpickingGameArea.w, &ctx.game.lockpickingGameArea.h);
+	{
+		int windowW;
+		int windowH;
+		SDL_GetWindowSize(ctx.system.window, &windowW, &windowH);
 
-	//	LIFECYCLE: Broadcast frame-initialization event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnFrameInitialization();
+		const bool wasResizing = ctx.engine.resize.IsResizing();
+		ctx.engine.resize.Update(windowW, windowH, SDL_GetTicks64());
+		if(ctx.engine.resize.IsResizing() != wasResizing)
+		{
+			if(ctx.engine.resize.IsResizing())
+				SDL_RenderSetLogicalSize(ctx.system.r, ctx.engine.resize.GetWidth(), ctx.engine.resize.GetHeight());
+			else
+				SDL_RenderSetLogicalSize(ctx.system.r, 0, 0);
+		}
+
+		ctx.game.lockpickingGameArea.w = ctx.engine.resize.GetWidth();
+		ctx.game.lockpickingGameArea.h = ctx.engine.resize.GetHeight();
+	}
+
+	//	LIFECYCLE: Run frame-initialization phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::FrameInitialization);
+	frameInitializationZone.End();
 #pragma endregion
 
 #pragma region Events/Input Loop
-		//	LIFECYCLE: Broadcast pre-events-loop event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnPreEventsLoop();
+	TraceZone eventsZone("Events Loop");
+
+		//	LIFECYCLE: Run pre-events-loop phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::PreEventsLoop);
 
 	// Events loop
 	SDL_Event currentEvent;
 	while(SDL_PollEvent(&currentEvent))
 	{
+		TraceZone dispatchZone(GetEventTraceName(currentEvent.type));
 		switch(currentEvent.type)
 		{
 #ifndef __EMSCRIPTEN__
@@ -360,9 +610,25 @@ void MainLoop()
 					case SDLK_ESCAPE:
 						ctx.engine.closeRequested = true;	//	Let's use the Escape button to quit the game
 						break;
+					//	On F2, show or hide the input latency overlay
+					case SDLK_F2:
+						ctx.debug.latencyOverlay.ToggleVisible();
+						break;
+					//	On F3, show or hide the runtime stats overlay
+					case SDLK_F3:
+						ctx.debug.statsOverlay.ToggleVisible();
+						break;
 				}
 				break;
 #endif
+			case SDL_RENDER_TARGETS_RESET:
+				//	Cached layers lost their content, draw them again
+				LayerCache::InvalidateAll();
+				break;
+			case SDL_RENDER_DEVICE_RESET:
+				//	Cached layers lost their textures too
+				LayerCache::ReleaseAll();
+				break;
 			case SDL_MOUSEBUTTONDOWN:
 				//	Only accept left mouse button (or touch emulation)
 				if(currentEvent.button.button != 1)
@@ -387,78 +653,108 @@ void MainLoop()
 				SDL_Point mousePosition = {currentEvent.motion.x, currentEvent.motion.y};
 				SDL_Point mousePrevPosition = {mousePosition.x - currentEvent.motion.xrel, mousePosition.y - currentEvent.motion.yrel};
 
-				// Feed move info to interactables
+				// Feed move info to interactables, along with the event time for latency measurements
 				for(IInteractable *& interactable : ctx.engine.interactionQueue)
-					interactable->MoveInteraction(mousePrevPosition, mousePosition);
+					interactable->MoveInteraction(mousePrevPosition, mousePosition, currentEvent.motion.timestamp);
 			}
 			break;
 		}
 	}
+	eventsZone.End();
 #pragma endregion
 
 #pragma region Render Loop
-		//	LIFECYCLE: Broadcast pre-render event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnPreRender();
+	TraceZone renderZone("Render");
+
+		//	LIFECYCLE: Run pre-render phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::PreRender);
 
 	// Clear
 	SDL_SetRenderDrawColor(ctx.system.r, COL_CLEAR);
-	SDL_RenderClear(ctx.system.r);
+	StatsRenderClear(ctx.system.r);
+
+	//	LIFECYCLE: Run post-render-clear phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::PostRenderClear);
 
-	//	LIFECYCLE: Broadcast post-render-clear event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnPostRenderClear();
+	//	Catch up with the pointer motion that arrived since the events loop
+	if(ctx.options.lateLatch)
+		LatchPointer();
 
 	//	Render all subscribed renderers
 	for(IRenderable const *& renderable : ctx.engine.renderQueue)
 		renderable->Render(ctx.system.r);
 
-	//	LIFECYCLE: Broadcast pre-render-present event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnPreRenderPresent();
+	//	LIFECYCLE: Run pre-render-present phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::PreRenderPresent);
+
+	renderZone.End();
 
 	// Display render
+	TraceZone presentZone("Present");
 	SDL_RenderPresent(ctx.system.r);
+	ctx.engine.pacer.OnPresent();
+	presentZone.End();
+
+	//	Inputs applied this frame are now on screen
+	ctx.engine.latency.OnPresent(SDL_GetTicks64());
+	ctx.benchmark.frames++;
 
-	//	LIFECYCLE: Broadcast post-render-present event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnPostRenderPresent();
+	//	In benchmark runs, feed the next frame some input (it arrives while we wait, as real input would)
+	if(ctx.options.benchmarkSeconds > 0.0f)
+		PushBenchmarkInput();
+
+	//	LIFECYCLE: Run post-render-present phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::PostRenderPresent);
 #pragma endregion
 
 #pragma region FPS Regulation
 	/*
-	 * We calculate the frame time, relative to the frame start time.
-	 * If it's below the target frame time, we'll wait for the difference.
-	 * If, instead, the frame take longer than the frame time we have two
-	 * roads to walk:
-	 * - variable frame time: we just don't wait and rush into the next frame
-	 * - fixed frame time: we skip a frame to align to the next fixed frame time
-	 *
-	 * Important note: when working with high resolution clock (or numbers
-	 * in general), data is usually stored in large data formats such as
-	 * long int or even long long int, so it's good practice to avoid
-	 * implicit conversions to make 100% clear what type of data we're
-	 * carying around.
-	 * 
-	 * As stated above, FPS regulation is entrusted to the browser for
-	 * webgl builds, so we'll skip the manual frame rate regulation here
-	 * too.
+	 * The pacer waits for the next frame according to the
+	 * presentation mode: nothing to do when present already
+	 * synced to the display or when running uncapped, a
+	 * sleep or a spin up to the target frame time otherwise.
+	 * When building for webgl, we let the browser decide
+	 * the frame rate, which will typically match the
+	 * monitor's refresh rate, so the pacer doesn't wait.
 	 */
-#ifndef __EMSCRIPTEN__
-	long long elapsedMillis = duration_cast<milliseconds>(high_resolution_clock::now() - frameStart).count();
-#ifdef FRAME_SKIP
-	elapsedMillis %= TARGET_FPS;
-#endif
-	long long waitMillis = (1000 / TARGET_FPS) - elapsedMillis;
-	if(waitMillis > 0)
-		SDL_Delay((int)waitMillis);
-#endif
+	{
+		TRACE_SCOPE("FPS Regulation");
+		ctx.engine.pacer.Wait();
+	}
 #pragma endregion
 
 #pragma region Frame End
-		//	LIFECYCLE: Broadcast frame-end event
-	for(ILifecycle *& lifecycleReceiver : ctx.engine.lifecycleQueue)
-		lifecycleReceiver->OnFrameEnd();
+	TraceZone frameEndZone("Frame End");
+
+		//	LIFECYCLE: Run frame-end phase systems
+	ctx.engine.scheduler.RunPhase(FramePhase::FrameEnd);
+
+	//	Close the frame's stats (nothing happens unless the stats overlay is up)
+	RenderStats::EndFrame(ctx.engine.pacer.GetLastFrameTime(), ctx.engine.pacer.GetLastInterval());
+
+	//	Labels drawn so far are no longer in use by the current frame
+	ctx.engine.text.NextFrame();
+
+	//	Let spectators know how the game is going
+	if(ctx.engine.publisher.IsOpen())
+	{
+		SharedGameState state;
+		ctx.game.lockpickingGame.GetSharedState(state);
+		ctx.engine.publisher.Publish(state);
+	}
+
+	//	Decide whether the next frame can wait for something to happen
+	ctx.engine.idleTimeout = GetIdleTimeout();
+
+	//	End benchmark runs on time
+	if(
+		ctx.options.benchmarkSeconds > 0.0f &&
+		SDL_GetTicks64() - ctx.benchmark.startTicks >= (Uint64)(ctx.options.benchmarkSeconds * 1000.0f)
+	)
+		ctx.engine.closeRequested = true;
+
+	frameEndZone.End();
+	frameZone.End();
 #pragma endregion
 
 #pragma region WebGL Shutdown
@@ -491,9 +787,184 @@ void SystemShutdown()
 #ifdef __EMSCRIPTEN__
 	emscripten_cancel_main_loop();
 #endif
+	if(ctx.options.benchmarkSeconds > 0.0f)
+		PrintBenchmarkReport();
+#ifdef _DEBUG
+	else
+		ctx.engine.pacer.PrintReport(cout);
+#endif
+	SetLatencyTracker(nullptr);
+	ctx.engine.jobs.Stop();
+	SetTraceLog(nullptr);
+	ctx.engine.trace.Stop();
+	SetTextRasterizer(nullptr);
+	ctx.engine.text.Shutdown();
+	ctx.engine.publisher.Close();
+	ctx.engine.telemetry.Stop();
+	if(ctx.engine.telemetry.GetFailed() > 0)
+		cout << "Telemetry: " << ctx.engine.telemetry.GetFailed() << " events could not be written to " << ctx.options.telemetryPath << endl;
 	TTF_Quit();
+	LayerCache::ReleaseAll();
 	SDL_DestroyRenderer(ctx.system.r);
 	SDL_DestroyWindow(ctx.system.window);
 	SDL_Quit();
 
 }
+
+Uint32 GetIdleTimeout()
+{
+	/*
+	 * The loop can sleep as long as every renderable keeps
+	 * drawing the same image and no timer is due. Labels
+	 * still being rasterized need to be redrawn as soon as
+	 * they're ready, so they keep the loop running.
+	 */
+	if(!ctx.options.idle || ctx.options.benchmarkSeconds > 0.0f || ctx.engine.text.HasPendingLabels())
+		return 0;
+
+	const Uint64 now = ctx.engine.clock.GetTicks();
+	const Uint64 nextTimer = ctx.engine.timers.GetNextDue();
+	Uint64 idleTime = nextTimer == (Uint64)-1 ? IDLE_FOREVER : (nextTimer > now ? nextTimer - now : 0);
+	for(IRenderable const *& renderable : ctx.engine.renderQueue)
+		idleTime = SDL_min(idleTime, renderable->GetIdleTime());
+
+	//	Game time may be scaled or paused
+	idleTime = ctx.engine.clock.ToRealTicks(idleTime);
+
+	//	A resize in progress must settle even if the window stops sending events
+	idleTime = SDL_min(idleTime, ctx.engine.resize.GetTimeToSettle(SDL_GetTicks64()));
+
+	//	Short waits are left to the frame pacing
+	if(idleTime < IDLE_MIN_TIMEOUT)
+		return 0;
+
+	return (Uint32)SDL_min(idleTime, (Uint64)IDLE_MAX_TIMEOUT);
+}
+
+void LatchPointer()
+{
+	TRACE_SCOPE("LatchPointer");
+
+	/*
+	 * Motion events are handled at the beginning of the
+	 * frame, then logic and lifecycle phases run before
+	 * anything gets drawn: by now the pointer has likely
+	 * moved further. Here we pump the OS events once more
+	 * and, if new motion came in, feed a single move to
+	 * the pointer's current position (the same reported by
+	 * SDL_GetMouseState, touch included through mouse
+	 * emulation), then drop the queued motion events so
+	 * the next frame doesn't apply them twice.
+	 * Events are already in renderer coordinates, the mouse
+	 * state is in window coordinates: they differ while a
+	 * resize is scaling the layout, so it gets mapped.
+	 * Button events must keep their order with respect to
+	 * motion, so if any is pending we leave everything to
+	 * the next frame's events loop.
+	 */
+	SDL_PumpEvents();
+
+	if(SDL_PeepEvents(nullptr, 0, SDL_PEEKEVENT, SDL_MOUSEBUTTONDOWN, SDL_MOUSEBUTTONUP) > 0)
+		return;
+
+	SDL_Event pendingMotion[LATE_LATCH_MAX_EVENTS];
+	const int pendingCount = SDL_PeepEvents(pendingMotion, LATE_LATCH_MAX_EVENTS, SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+	if(pendingCount <= 0 || SDL_PeepEvents(nullptr, 0, SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION) > pendingCount)
+		return;
+
+	//	Move from where the first pending event started to where the pointer is now
+	const SDL_MouseMotionEvent & first = pendingMotion[0].motion;
+	const SDL_Point from = {first.x - first.xrel, first.y - first.yrel};
+	int windowX;
+	int windowY;
+	float logicalX;
+	float logicalY;
+	SDL_GetMouseState(&windowX, &windowY);
+	SDL_RenderWindowToLogical(ctx.system.r, windowX, windowY, &logicalX, &logicalY);
+	const SDL_Point to = {(int)logicalX, (int)logicalY};
+	SDL_FlushEvent(SDL_MOUSEMOTION);
+
+	//	Latency is accounted from the oldest input being applied
+	for(IInteractable *& interactable : ctx.engine.interactionQueue)
+		interactable->MoveInteraction(from, to, first.timestamp);
+}
+
+void PushBenchmarkInput()
+{
+	/*
+	 * Drag along a circle around the window center, where
+	 * the keypad wheel is. Pushed events get stamped by SDL
+	 * when pushed, just like real ones when they arrive.
+	 */
+	int w;
+	int h;
+	SDL_GetWindowSize(ctx.system.window, &w, &h);
+	const float radius = (w < h ? w : h) * BENCHMARK_DRAG_RADIUS_RATIO;
+	const SDL_Point from = {w / 2 + (int)(radius * cosf(ctx.benchmark.dragAngle)), h / 2 + (int)(radius * sinf(ctx.benchmark.dragAngle))};
+	ctx.benchmark.dragAngle += BENCHMARK_DRAG_STEP;
+	const SDL_Point to = {w / 2 + (int)(radius * cosf(ctx.benchmark.dragAngle)), h / 2 + (int)(radius * sinf(ctx.benchmark.dragAngle))};
+
+	SDL_Event event;
+	SDL_zero(event);
+
+	//	Grab the wheel on the first frame
+	if(ctx.benchmark.frames == 1)
+	{
+		event.type = SDL_MOUSEBUTTONDOWN;
+		event.button.button = SDL_BUTTON_LEFT;
+		event.button.state = SDL_PRESSED;
+		event.button.x = from.x;
+		event.button.y = from.y;
+		SDL_PushEvent(&event);
+		SDL_zero(event);
+	}
+
+	event.type = SDL_MOUSEMOTION;
+	event.motion.state = SDL_BUTTON_LMASK;
+	event.motion.x = to.x;
+	event.motion.y = to.y;
+	event.motion.xrel = to.x - from.x;
+	event.motion.yrel = to.y - from.y;
+	SDL_PushEvent(&event);
+}
+
+void PrintBenchmarkReport()
+{
+	const double seconds = (SDL_GetTicks64() - ctx.benchmark.startTicks) / 1000.0;
+
+	cout << "Benchmark: " << ctx.benchmark.frames << " frames in " << seconds << " s";
+	if(seconds > 0.0)
+		cout << " (" << ctx.benchmark.frames / seconds << " FPS)";
+	cout << endl;
+	ctx.engine.pacer.PrintReport(cout);
+	ctx.engine.latency.PrintReport(cout);
+	LayerCache::PrintReport(cout);
+	ctx.engine.text.PrintReport(cout);
+	cout << "Window resizes: " << ctx.engine.resize.GetSettledCount() << " applied, " << ctx.engine.resize.GetSkippedCount() << " intermediate sizes skipped" << endl;
+}
+
+const char * GetEventTraceName(Uint32 type)
+{
+	//	Trace zones keep their name pointer, so one literal per event type
+	switch(type)
+	{
+		case SDL_QUIT:
+			return "Event: Quit";
+		case SDL_KEYDOWN:
+			return "Event: Key Down";
+		case SDL_MOUSEBUTTONDOWN:
+			return "Event: Mouse Button Down";
+		case SDL_MOUSEBUTTONUP:
+			return "Event: Mouse Button Up";
+		case SDL_MOUSEMOTION:
+			return "Event: Mouse Motion";
+		case SDL_WINDOWEVENT:
+			return "Event: Window";
+		case SDL_RENDER_TARGETS_RESET:
+			return "Event: Render Targets Reset";
+		case SDL_RENDER_DEVICE_RESET:
+			return "Event: Render Device Reset";
+		default:
+			return "Event: Other";
+	}
+}
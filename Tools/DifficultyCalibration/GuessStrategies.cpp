@@ -0,0 +1,135 @@
+#include "GuessStrategies.h"
+
+#pragma region Random Guess
+void RandomGuessStrategy::NextGuess(const GameRules & rules, FastRandom & random, const int, Code & guess)
+{
+	for(size_t d = 0; d < guess.size(); d++)
+		guess[d] = (CharIndex)random(rules.GetCharsetLength());
+}
+#pragma endregion
+
+#pragma region Elimination
+void EliminationStrategy::BeginStage(const GameRules & rules)
+{
+	//	A new code: every character is possible again in every place
+	candidates.assign((size_t)rules.GetCodeLength() * rules.GetCharsetLength(), (Uint8)1);
+	candidatesCount.assign(rules.GetCodeLength(), rules.GetCharsetLength());
+}
+
+void EliminationStrategy::NextGuess(const GameRules & rules, FastRandom & random, const int, Code & guess)
+{
+	const int charsetLength = rules.GetCharsetLength();
+
+	for(size_t d = 0; d < guess.size(); d++)
+		guess[d] = (CharIndex)PickRandomCandidate((int)d, charsetLength, random);
+}
+
+void EliminationStrategy::Feedback(const GameRules & rules, const Code & guess, const Uint8 * digitErrors)
+{
+	const int charsetLength = rules.GetCharsetLength();
+
+	/*
+	 * Drop every candidate that would have produced a different
+	 * hint for the character we dialed. Asking the rules for the
+	 * error keeps this correct whatever the distance metric is.
+	 */
+	for(size_t d = 0; d < guess.size(); d++)
+	{
+		const Uint8 observed = GetDigitHint(digitErrors[d]);
+		Uint8 * digitCandidates = &candidates[d * charsetLength];
+
+		for(int c = 0; c < charsetLength; c++)
+			if(
+				digitCandidates[c] &&
+				GetDigitHint(rules.GetCharacterError(guess[d], (CharIndex)c)) != observed
+			)
+			{
+				digitCandidates[c] = 0;
+				candidatesCount[d]--;
+			}
+	}
+}
+
+int EliminationStrategy::PickRandomCandidate(const int digit, const int charsetLength, FastRandom & random) const
+{
+	const Uint8 * digitCandidates = &candidates[(size_t)digit * charsetLength];
+
+	//	Hints never lie, but stay safe if the set gets emptied anyway
+	if(candidatesCount[digit] < 1)
+		return random(charsetLength);
+
+	int pick = random(candidatesCount[digit]);
+	for(int c = 0; c < charsetLength; c++)
+		if(digitCandidates[c] && pick-- == 0)
+			return c;
+
+	return 0;
+}
+#pragma endregion
+
+#pragma region Nearest Candidate
+void NearestCandidateStrategy::NextGuess(const GameRules & rules, FastRandom & random, const int wheelSlot, Code & guess)
+{
+	const int charsetLength = rules.GetCharsetLength();
+	int slot = wheelSlot;
+
+	for(size_t d = 0; d < guess.size(); d++)
+	{
+		const Uint8 * digitCandidates = &candidates[d * charsetLength];
+
+		//	Walk both directions from the current slot until a candidate is met
+		int pick = -1;
+		for(int step = 0; step <= charsetLength / 2 && pick < 0; step++)
+		{
+			const int forward = (slot + step) % charsetLength;
+			const int backward = (slot - step + charsetLength) % charsetLength;
+			if(digitCandidates[forward])
+				pick = forward;
+			else if(digitCandidates[backward])
+				pick = backward;
+		}
+		if(pick < 0)
+			pick = random(charsetLength);
+
+		guess[d] = (CharIndex)pick;
+		slot = pick;
+	}
+}
+#pragma endregion
+
+#pragma region Registry
+int GetStrategiesCount()
+{
+	return 3;
+}
+
+const char * GetStrategyName(const int strategy)
+{
+	switch(strategy)
+	{
+		case 0: return "random";
+		case 1: return "eliminate";
+		case 2: return "nearest";
+	}
+	return "unknown";
+}
+
+int FindStrategy(const string & name)
+{
+	for(int s = 0; s < GetStrategiesCount(); s++)
+		if(name == GetStrategyName(s))
+			return s;
+	return -1;
+}
+
+IGuessStrategy * CreateStrategy(const int strategy)
+{
+	switch(strategy)
+	{
+		case 0: return new RandomGuessStrategy();
+		case 1: return new EliminationStrategy();
+		case 2: return new NearestCandidateStrategy();
+	}
+	return nullptr;
+}
+#pragma endregion
@@ -0,0 +1,90 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region Game Includes
+#include "GameRules.h"
+#include "SharedState.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "Simulation.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Interface for simulated players.
+ * A strategy is owned by a single simulation thread and reused
+ * for many games, so it must reset its own state in BeginStage.
+ */
+class IGuessStrategy
+{
+public:
+	virtual ~IGuessStrategy() { }
+	virtual const char * GetName() const = 0;
+	//	Called whenever a new code must be guessed (game start or stage cleared)
+	virtual void BeginStage(const GameRules & rules) = 0;
+	//	Fills guess (already sized to the code length) with the next attempt
+	virtual void NextGuess(const GameRules & rules, FastRandom & random, const int wheelSlot, Code & guess) = 0;
+	//	Receives the per-digit errors of a wrong guess
+	virtual void Feedback(const GameRules & rules, const Code & guess, const Uint8 * digitErrors) = 0;
+};
+
+/*
+ * Memoryless player: every guess is random, hints are ignored.
+ * It's the lower bound every configuration should be checked
+ * against (nobody should win by mashing the button).
+ */
+class RandomGuessStrategy : public IGuessStrategy
+{
+public:
+	const char * GetName() const override { return "random"; }
+	void BeginStage(const GameRules &) override { }
+	void NextGuess(const GameRules & rules, FastRandom & random, const int wheelSlot, Code & guess) override;
+	void Feedback(const GameRules &, const Code &, const Uint8 *) override { }
+};
+
+/*
+ * Careful player: keeps, for each digit, the set of characters
+ * still compatible with all the hints received so far, and picks
+ * a random one among them.
+ */
+class EliminationStrategy : public IGuessStrategy
+{
+	// Fields
+protected:
+	vector<Uint8> candidates;	//	codeLength x charsetLength flags
+	vector<int> candidatesCount;
+	// Methods
+public:
+	const char * GetName() const override { return "eliminate"; }
+	void BeginStage(const GameRules & rules) override;
+	void NextGuess(const GameRules & rules, FastRandom & random, const int wheelSlot, Code & guess) override;
+	void Feedback(const GameRules & rules, const Code & guess, const Uint8 * digitErrors) override;
+protected:
+	int PickRandomCandidate(const int digit, const int charsetLength, FastRandom & random) const;
+};
+
+/*
+ * Lazy player: same bookkeeping as the careful one, but among
+ * the compatible characters it dials the one closest to where
+ * the wheel currently is, trading information for input time.
+ */
+class NearestCandidateStrategy : public EliminationStrategy
+{
+public:
+	const char * GetName() const override { return "nearest"; }
+	void NextGuess(const GameRules & rules, FastRandom & random, const int wheelSlot, Code & guess) override;
+};
+
+/*
+ * Strategy registry, used to build one instance per thread.
+ */
+int GetStrategiesCount();
+const char * GetStrategyName(const int strategy);
+int FindStrategy(const string & name);
+IGuessStrategy * CreateStrategy(const int strategy);
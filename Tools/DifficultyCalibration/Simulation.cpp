@@ -0,0 +1,73 @@
+#include "Simulation.h"
+
+#pragma region C++ Includes
+#include <vector>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "GuessStrategies.h"
+#pragma endregion
+
+void SimulateGames(
+	GameRules & rules, IGuessStrategy & strategy,
+	const InputTimeModel & timing, FastRandom & random,
+	const Uint64 games, SimulationResult & result
+)
+{
+	const int charsetLength = rules.GetCharsetLength();
+	const int codeLength = rules.GetCodeLength();
+
+	//	Buffers reused by every guess, no allocation happens inside the game loop
+	Code guess(codeLength, 0);
+	vector<Uint8> digitErrors(codeLength);
+
+	for(Uint64 g = 0; g < games; g++)
+	{
+		rules.Restart(random);
+		strategy.BeginStage(rules);
+
+		Uint64 elapsed = 0;
+		int wheelSlot = 0;	//	The keypad starts with the first character on top
+
+		while(!rules.AreStagesCleared())
+		{
+			//	Think, then dial the guess digit by digit
+			elapsed += timing.msPerGuess;
+			strategy.NextGuess(rules, random, wheelSlot, guess);
+			for(int d = 0; d < codeLength; d++)
+			{
+				const int targetSlot = guess[d];	//	Codes are wheel slots already
+				int distance = targetSlot > wheelSlot ? targetSlot - wheelSlot : wheelSlot - targetSlot;
+				if(distance > charsetLength - distance)
+					distance = charsetLength - distance;
+				elapsed += (Uint64)distance * timing.msPerSlot + timing.msPerPress;
+				wheelSlot = targetSlot;
+			}
+
+			//	The bomb doesn't wait for the last digit
+			if(rules.IsTimeUp(elapsed))
+				break;
+
+			result.guesses++;
+
+			//	Same flow as the game: evaluate for hints, then submit
+			rules.EvaluateCodeError(guess, digitErrors.data());
+			if(rules.SubmitCode(guess, random))
+			{
+				result.stagesCleared++;
+				if(!rules.AreStagesCleared())
+					elapsed += timing.msStageClear;	//	Input is locked while the cleared code stays on screen
+				strategy.BeginStage(rules);
+			}
+			else
+				strategy.Feedback(rules, guess, digitErrors.data());
+		}
+
+		result.games++;
+		if(rules.AreStagesCleared() && !rules.IsTimeUp(elapsed))
+		{
+			result.wins++;
+			result.winMillisLeft += rules.GetSolveTime() - elapsed;
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "GameRules.h"
+#pragma endregion
+
+using namespace std;
+
+class IGuessStrategy;
+
+/*
+ * A tiny, fast and deterministic random source (splitmix64).
+ * The game uses a fresh random_device for every number, which
+ * is perfect for a handful of codes per game but way too slow
+ * to simulate millions of games. Each simulation thread owns
+ * one of these, seeded differently.
+ * It can be fed directly to GameRules as an index source.
+ */
+class FastRandom
+{
+	// Fields
+private:
+	Uint64 state;
+	// Constructors
+public:
+	FastRandom(Uint64 seed) : state(seed) { }
+	// Methods
+public:
+	__inline Uint64 Next()
+	{
+		Uint64 z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+	//	Returns a number in [0, length), the signature GameRules expects from an index source
+	__inline int operator()(const int length) { return (int)((Next() >> 33) % (Uint64)length); }
+};
+
+/*
+ * Models how long a human takes to interact with the keypad.
+ * All values are milliseconds.
+ */
+typedef struct
+{
+	Uint32 msPerSlot;		//	Rotating the wheel by one slot
+	Uint32 msPerPress;		//	Pressing the submit button once
+	Uint32 msPerGuess;		//	Reading the hints and deciding the next guess
+	Uint32 msStageClear;	//	Input lock after a stage is cleared (the game's stage clear routine)
+} InputTimeModel;
+
+/*
+ * One point of the sweep: game parameters plus the strategy
+ * used by the simulated player.
+ */
+typedef struct
+{
+	int codeDigits;
+	int stages;
+	int secondsPerStage;
+	int strategy;
+} SimulationConfig;
+
+/*
+ * Accumulated outcome of a batch of simulated games.
+ */
+typedef struct
+{
+	Uint64 games;
+	Uint64 wins;
+	Uint64 stagesCleared;
+	Uint64 guesses;
+	Uint64 winMillisLeft;
+} SimulationResult;
+
+/*
+ * Runs a batch of games with the given rules, strategy and time
+ * model, accumulating the outcome in result.
+ * Rules are restarted for each game, so any instance can be reused.
+ */
+void SimulateGames(
+	GameRules & rules, IGuessStrategy & strategy,
+	const InputTimeModel & timing, FastRandom & random,
+	const Uint64 games, SimulationResult & result
+);
@@ -0,0 +1,350 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#pragma endregion
+
+#pragma region Game Includes
+#include "GameRules.h"
+#include "Charset.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "Simulation.h"
+#include "GuessStrategies.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Monte Carlo difficulty calibration.
+ * Sweeps code length, stages count and seconds per stage (the
+ * CODE_DIGITS, STAGES_COUNT and SECONDS_PER_STAGE parameters of
+ * LockpickingGame) and, for each configuration and each simulated
+ * player strategy, plays a large number of games against the real
+ * GameRules, reporting the win rate.
+ * Work is split in small chunks picked by all threads from a
+ * shared counter, so every core stays busy until the very end
+ * whatever the cost of each configuration is.
+ */
+
+#pragma region Constant Parameters
+//	Defaults, matching the values shipped with the game
+#define DEFAULT_CHARSET "0123456789"
+#define DEFAULT_GAMES 100000
+#define DEFAULT_SEED 0x5D1C0DEULL
+
+//	Input time model defaults (milliseconds)
+#define DEFAULT_MS_PER_SLOT 90
+#define DEFAULT_MS_PER_PRESS 350
+#define DEFAULT_MS_PER_GUESS 1200
+#define DEFAULT_MS_STAGE_CLEAR 1050
+
+//	Games simulated by a thread each time it picks some work
+#define GAMES_PER_CHUNK 4096
+
+#define TICKS_PER_SECOND 1000
+#pragma endregion
+
+#pragma region Options
+typedef struct
+{
+	string charset;
+	vector<int> codeDigits;
+	vector<int> stages;
+	vector<int> secondsPerStage;
+	vector<int> strategies;
+	Uint64 games;
+	int threads;
+	Uint64 seed;
+	InputTimeModel timing;
+	string csvPath;
+} Options;
+
+static vector<int> ParseList(const string & text)
+{
+	vector<int> values;
+	istringstream stream(text);
+	string item;
+	while(getline(stream, item, ','))
+		if(!item.empty())
+			values.push_back(atoi(item.c_str()));
+	return values;
+}
+
+//	Sweeps are only valid when every value fits the game rules
+static bool IsListWithin(const vector<int> & values, const int low, const int high)
+{
+	for(const int & value : values)
+		if(value < low || value > high)
+			return false;
+	return !values.empty();
+}
+
+static void PrintUsage()
+{
+	cout << "Usage: DifficultyCalibration [options]" << endl;
+	cout << "  --games N             games per configuration (default " << DEFAULT_GAMES << ")" << endl;
+	cout << "  --threads N           worker threads (default: all cores)" << endl;
+	cout << "  --digits a,b,..       code lengths to sweep" << endl;
+	cout << "  --stages a,b,..       stages counts to sweep" << endl;
+	cout << "  --seconds a,b,..      seconds per stage to sweep" << endl;
+	cout << "  --strategies a,b,..   simulated players (random, eliminate, nearest)" << endl;
+	cout << "  --charset STRING      wheel symbols, UTF-8 (default " << DEFAULT_CHARSET << ")" << endl;
+	cout << "  --ms-per-slot N       time to rotate the wheel by one slot" << endl;
+	cout << "  --ms-per-press N      time to press the submit button" << endl;
+	cout << "  --ms-per-guess N      thinking time before each guess" << endl;
+	cout << "  --ms-stage-clear N    input lock after a cleared stage" << endl;
+	cout << "  --seed N              base random seed" << endl;
+	cout << "  --csv PATH            also write all results as CSV" << endl;
+}
+
+static bool ParseOptions(int argc, char * argv[], Options & options)
+{
+	options.charset = DEFAULT_CHARSET;
+	options.codeDigits = {3, 4, 5, 6};
+	options.stages = {1, 2, 3, 4};
+	options.secondsPerStage = {30, 45, 60, 90, 120};
+	for(int s = 0; s < GetStrategiesCount(); s++)
+		options.strategies.push_back(s);
+	options.games = DEFAULT_GAMES;
+	options.threads = (int)thread::hardware_concurrency();
+	options.seed = DEFAULT_SEED;
+	options.timing = {DEFAULT_MS_PER_SLOT, DEFAULT_MS_PER_PRESS, DEFAULT_MS_PER_GUESS, DEFAULT_MS_STAGE_CLEAR};
+
+	for(int a = 1; a < argc; a++)
+	{
+		const string arg = argv[a];
+		if(arg == "--help" || arg == "-h")
+			return false;
+		if(a + 1 >= argc)
+		{
+			cout << "Missing value for " << arg << endl;
+			return false;
+		}
+		const string value = argv[++a];
+
+		if(arg == "--games")
+			options.games = strtoull(value.c_str(), nullptr, 10);
+		else if(arg == "--threads")
+			options.threads = atoi(value.c_str());
+		else if(arg == "--digits")
+			options.codeDigits = ParseList(value);
+		else if(arg == "--stages")
+			options.stages = ParseList(value);
+		else if(arg == "--seconds")
+			options.secondsPerStage = ParseList(value);
+		else if(arg == "--strategies")
+		{
+			options.strategies.clear();
+			istringstream stream(value);
+			string name;
+			while(getline(stream, name, ','))
+			{
+				const int strategy = FindStrategy(name);
+				if(strategy < 0)
+				{
+					cout << "Unknown strategy: " << name << endl;
+					return false;
+				}
+				options.strategies.push_back(strategy);
+			}
+		}
+		else if(arg == "--charset")
+			options.charset = value;
+		else if(arg == "--ms-per-slot")
+			options.timing.msPerSlot = (Uint32)atoi(value.c_str());
+		else if(arg == "--ms-per-press")
+			options.timing.msPerPress = (Uint32)atoi(value.c_str());
+		else if(arg == "--ms-per-guess")
+			options.timing.msPerGuess = (Uint32)atoi(value.c_str());
+		else if(arg == "--ms-stage-clear")
+			options.timing.msStageClear = (Uint32)atoi(value.c_str());
+		else if(arg == "--seed")
+			options.seed = strtoull(value.c_str(), nullptr, 0);
+		else if(arg == "--csv")
+			options.csvPath = value;
+		else
+		{
+			cout << "Unknown option: " << arg << endl;
+			return false;
+		}
+	}
+
+	if(options.threads < 1)
+		options.threads = 1;
+
+	//	GameRules keeps the whole game time (stages times stage time) in 32 bit milliseconds
+	return
+		!options.charset.empty() &&
+		IsListWithin(options.codeDigits, 1, 255) &&
+		IsListWithin(options.stages, 1, 255) &&
+		IsListWithin(options.secondsPerStage, 1, SDL_MAX_UINT32 / (TICKS_PER_SECOND * 255)) &&
+		!options.strategies.empty() &&
+		options.games > 0;
+}
+#pragma endregion
+
+#pragma region Output
+static double GetWinRate(const SimulationResult & result)
+{
+	return result.games ? 100.0 * result.wins / result.games : 0.0;
+}
+
+static void PrintTables(const Options & options, const vector<SimulationConfig> &, const vector<SimulationResult> & results)
+{
+	/*
+	 * One table per strategy: rows are (digits, stages), columns
+	 * are seconds per stage, cells are win rates.
+	 */
+	size_t index = 0;
+	for(size_t s = 0; s < options.strategies.size(); s++)
+	{
+		cout << endl << "Strategy: " << GetStrategyName(options.strategies[s]) << " (win rate %)" << endl;
+		cout << setw(16) << "digits x stages";
+		for(size_t t = 0; t < options.secondsPerStage.size(); t++)
+			cout << setw(9) << (to_string(options.secondsPerStage[t]) + "s");
+		cout << endl;
+
+		for(size_t d = 0; d < options.codeDigits.size(); d++)
+			for(size_t st = 0; st < options.stages.size(); st++)
+			{
+				cout << setw(16) << (to_string(options.codeDigits[d]) + " x " + to_string(options.stages[st]));
+				for(size_t t = 0; t < options.secondsPerStage.size(); t++)
+					cout << setw(9) << fixed << setprecision(2) << GetWinRate(results[index++]);
+				cout << endl;
+			}
+	}
+}
+
+static bool WriteCsv(const string & path, const vector<SimulationConfig> & configs, const vector<SimulationResult> & results)
+{
+	ofstream csv(path.c_str());
+	if(!csv)
+		return false;
+
+	csv << "strategy,digits,stages,seconds_per_stage,games,wins,win_rate,avg_stages_cleared,avg_guesses_per_stage,avg_seconds_left_on_win" << endl;
+	for(size_t c = 0; c < configs.size(); c++)
+	{
+		const SimulationConfig & config = configs[c];
+		const SimulationResult & result = results[c];
+		csv << GetStrategyName(config.strategy) << ','
+			<< config.codeDigits << ','
+			<< config.stages << ','
+			<< config.secondsPerStage << ','
+			<< result.games << ','
+			<< result.wins << ','
+			<< GetWinRate(result) << ','
+			<< (result.games ? (double)result.stagesCleared / result.games : 0.0) << ','
+			<< (result.stagesCleared ? (double)result.guesses / result.stagesCleared : 0.0) << ','
+			<< (result.wins ? (double)result.winMillisLeft / result.wins / TICKS_PER_SECOND : 0.0) << endl;
+	}
+
+	return true;
+}
+#pragma endregion
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	Options options;
+	if(!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	//	Decode the symbols once, every game works on their slots
+	const Charset charset(options.charset);
+
+	//	Build the sweep, strategy-major so tables can be printed in order
+	vector<SimulationConfig> configs;
+	for(const int & strategy : options.strategies)
+		for(const int & digits : options.codeDigits)
+			for(const int & stages : options.stages)
+				for(const int & seconds : options.secondsPerStage)
+					configs.push_back({digits, stages, seconds, strategy});
+
+	const Uint64 chunksPerConfig = (options.games + GAMES_PER_CHUNK - 1) / GAMES_PER_CHUNK;
+	const Uint64 totalChunks = chunksPerConfig * configs.size();
+
+	cout << "Simulating " << configs.size() << " configurations x " << options.games << " games on " << options.threads << " threads" << endl;
+
+	/*
+	 * Each thread accumulates into its own results, merged at
+	 * the end: the only shared write is the chunk counter.
+	 */
+	atomic<Uint64> nextChunk(0);
+	vector<vector<SimulationResult>> threadResults(options.threads, vector<SimulationResult>(configs.size(), SimulationResult{0, 0, 0, 0, 0}));
+
+	steady_clock::time_point start = steady_clock::now();
+
+	vector<thread> workers;
+	for(int t = 0; t < options.threads; t++)
+		workers.push_back(thread([&, t]()
+		{
+			vector<SimulationResult> & results = threadResults[t];
+			vector<IGuessStrategy *> strategies;
+			for(int s = 0; s < GetStrategiesCount(); s++)
+				strategies.push_back(CreateStrategy(s));
+
+			for(Uint64 chunk = nextChunk++; chunk < totalChunks; chunk = nextChunk++)
+			{
+				const size_t configIndex = (size_t)(chunk / chunksPerConfig);
+				const Uint64 chunkInConfig = chunk % chunksPerConfig;
+				const SimulationConfig & config = configs[configIndex];
+				const Uint64 firstGame = chunkInConfig * GAMES_PER_CHUNK;
+				const Uint64 games = firstGame + GAMES_PER_CHUNK > options.games ? options.games - firstGame : GAMES_PER_CHUNK;
+
+				//	Seeding by chunk makes results independent from the threads count
+				FastRandom random(options.seed ^ (chunk * 0x9E3779B97F4A7C15ULL));
+				GameRules rules(
+					charset,
+					(Uint8)config.codeDigits,
+					(Uint8)config.stages,
+					(Uint32)config.secondsPerStage * TICKS_PER_SECOND
+				);
+				SimulateGames(rules, *strategies[config.strategy], options.timing, random, games, results[configIndex]);
+			}
+
+			for(IGuessStrategy * strategy : strategies)
+				delete strategy;
+		}));
+	for(thread & worker : workers)
+		worker.join();
+
+	const double seconds = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+	//	Merge per-thread results
+	vector<SimulationResult> results(configs.size(), SimulationResult{0, 0, 0, 0, 0});
+	for(const vector<SimulationResult> & partial : threadResults)
+		for(size_t c = 0; c < configs.size(); c++)
+		{
+			results[c].games += partial[c].games;
+			results[c].wins += partial[c].wins;
+			results[c].stagesCleared += partial[c].stagesCleared;
+			results[c].guesses += partial[c].guesses;
+			results[c].winMillisLeft += partial[c].winMillisLeft;
+		}
+
+	PrintTables(options, configs, results);
+
+	const double totalGames = (double)options.games * configs.size();
+	cout << endl << fixed << setprecision(2) << totalGames / 1e6 << "M games in " << seconds << "s (" << totalGames / seconds / 1e6 << "M games/s)" << endl;
+
+	if(!options.csvPath.empty() && !WriteCsv(options.csvPath, configs, results))
+	{
+		cout << "Couldn't write CSV file: " << options.csvPath << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,257 @@
+#include "ColumnCodec.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#pragma endregion
+
+//	The low bits of a 64 bit word (all of them for 64)
+static __inline Uint64 LowMask(const int bits)
+{
+	return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+void ColumnCodec::Encode(const Uint64 * values, size_t count, Uint8 width, vector<Uint8> & out, ColumnChunk & chunk)
+{
+	//	Zone map first: it also frames the bit packing and run length encodings
+	Uint64 minValue = count > 0 ? values[0] : 0;
+	Uint64 maxValue = minValue;
+	for(size_t v = 1; v < count; v++)
+	{
+		minValue = values[v] < minValue ? values[v] : minValue;
+		maxValue = values[v] > maxValue ? values[v] : maxValue;
+	}
+
+	Uint8 bitWidth = 0;
+	while(bitWidth < 64 && (maxValue - minValue) > LowMask(bitWidth))
+		bitWidth++;
+
+	memset(&chunk, 0, sizeof(chunk));
+	chunk.minValue = minValue;
+	chunk.maxValue = maxValue;
+	chunk.bitWidth = bitWidth;
+
+	//	Bit packing is the fastest to decode, the others only win when clearly smaller
+	out.clear();
+	EncodeBitPack(values, count, minValue, bitWidth, out);
+	chunk.encoding = (Uint8)ColumnEncoding::BitPack;
+
+	vector<Uint8> candidate;
+	EncodeRunLength(values, count, minValue, candidate);
+	if(candidate.size() < out.size())
+	{
+		out.swap(candidate);
+		chunk.encoding = (Uint8)ColumnEncoding::RunLength;
+	}
+
+	EncodeDelta(values, count, candidate);
+	if(candidate.size() < out.size())
+	{
+		out.swap(candidate);
+		chunk.encoding = (Uint8)ColumnEncoding::Delta;
+	}
+
+	if(count * width <= out.size())
+	{
+		EncodePlain(values, count, width, out);
+		chunk.encoding = (Uint8)ColumnEncoding::Plain;
+	}
+}
+
+bool ColumnCodec::Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint8 * out)
+{
+	return DecodeValues(data, chunk, count, out);
+}
+
+bool ColumnCodec::Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint16 * out)
+{
+	return DecodeValues(data, chunk, count, out);
+}
+
+bool ColumnCodec::Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint32 * out)
+{
+	return DecodeValues(data, chunk, count, out);
+}
+
+bool ColumnCodec::Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint64 * out)
+{
+	return DecodeValues(data, chunk, count, out);
+}
+
+void ColumnCodec::EncodePlain(const Uint64 * values, size_t count, Uint8 width, vector<Uint8> & out)
+{
+	out.resize(count * width);
+	for(size_t v = 0; v < count; v++)
+		for(int b = 0; b < width; b++)
+			out[v * width + b] = (Uint8)(values[v] >> (8 * b));
+}
+
+void ColumnCodec::EncodeBitPack(const Uint64 * values, size_t count, Uint64 minValue, Uint8 bitWidth, vector<Uint8> & out)
+{
+	out.clear();
+	out.reserve((count * bitWidth + 7) / 8);
+
+	//	One little-endian bit stream, written a word at a time
+	Uint64 word = 0;
+	int bits = 0;
+	for(size_t v = 0; v < count; v++)
+	{
+		Uint64 offset = values[v] - minValue;
+		int remaining = bitWidth;
+		while(remaining > 0)
+		{
+			const int take = SDL_min(remaining, 64 - bits);
+			word |= (offset & LowMask(take)) << bits;
+			offset = take >= 64 ? 0 : offset >> take;
+			bits += take;
+			remaining -= take;
+			if(bits == 64)
+			{
+				for(int b = 0; b < 8; b++)
+					out.push_back((Uint8)(word >> (8 * b)));
+				word = 0;
+				bits = 0;
+			}
+		}
+	}
+	for(int b = 0; b < bits; b += 8)
+		out.push_back((Uint8)(word >> b));
+}
+
+void ColumnCodec::EncodeRunLength(const Uint64 * values, size_t count, Uint64 minValue, vector<Uint8> & out)
+{
+	out.clear();
+	for(size_t v = 0; v < count; )
+	{
+		size_t run = 1;
+		while(v + run < count && values[v + run] == values[v])
+			run++;
+		PutVarint(out, values[v] - minValue);
+		PutVarint(out, run);
+		v += run;
+	}
+}
+
+void ColumnCodec::EncodeDelta(const Uint64 * values, size_t count, vector<Uint8> & out)
+{
+	out.clear();
+	if(count < 1)
+		return;
+
+	PutVarint(out, values[0]);
+	for(size_t v = 1; v < count; v++)
+	{
+		//	Zigzag keeps small negative differences small
+		const Sint64 difference = (Sint64)(values[v] - values[v - 1]);
+		PutVarint(out, ((Uint64)difference << 1) ^ (Uint64)(difference >> 63));
+	}
+}
+
+void ColumnCodec::PutVarint(vector<Uint8> & out, Uint64 value)
+{
+	while(value >= 0x80)
+	{
+		out.push_back((Uint8)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((Uint8)value);
+}
+
+bool ColumnCodec::GetVarint(const Uint8 * & data, const Uint8 * end, Uint64 & value)
+{
+	value = 0;
+	for(int shift = 0; shift < 64 && data < end; shift += 7)
+	{
+		const Uint8 byte = *data++;
+		value |= (Uint64)(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+template<typename T> bool ColumnCodec::DecodeValues(const Uint8 * data, const ColumnChunk & chunk, size_t count, T * out)
+{
+	const Uint8 * end = data + chunk.size;
+	switch((ColumnEncoding)chunk.encoding)
+	{
+		case ColumnEncoding::Plain:
+		{
+			//	Stored in the column width, little-endian like the host
+			if(chunk.size != count * sizeof(T))
+				return false;
+			memcpy(out, data, chunk.size);
+			return true;
+		}
+		case ColumnEncoding::BitPack:
+		{
+			const int bitWidth = chunk.bitWidth;
+			if(bitWidth > 64 || chunk.size < (count * bitWidth + 7) / 8)
+				return false;
+
+			//	Constant chunks take no bytes at all
+			if(bitWidth == 0)
+			{
+				for(size_t v = 0; v < count; v++)
+					out[v] = (T)chunk.minValue;
+				return true;
+			}
+
+			Uint64 word = 0;
+			int bits = 0;
+			for(size_t v = 0; v < count; v++)
+			{
+				Uint64 offset = 0;
+				int got = 0;
+				while(got < bitWidth)
+				{
+					if(bits == 0)
+					{
+						//	Refill a word, the last one may be short
+						word = 0;
+						for(; bits < 64 && data < end; bits += 8)
+							word |= (Uint64)*data++ << bits;
+						if(bits == 0)
+							return false;
+					}
+					const int take = SDL_min(bitWidth - got, bits);
+					offset |= (word & LowMask(take)) << got;
+					word = take >= 64 ? 0 : word >> take;
+					bits -= take;
+					got += take;
+				}
+				out[v] = (T)(chunk.minValue + offset);
+			}
+			return true;
+		}
+		case ColumnEncoding::RunLength:
+		{
+			size_t v = 0;
+			while(v < count)
+			{
+				Uint64 offset;
+				Uint64 run;
+				if(!GetVarint(data, end, offset) || !GetVarint(data, end, run) || run > count - v)
+					return false;
+				const T value = (T)(chunk.minValue + offset);
+				for(const size_t runEnd = v + (size_t)run; v < runEnd; v++)
+					out[v] = value;
+			}
+			return true;
+		}
+		case ColumnEncoding::Delta:
+		{
+			Uint64 value = 0;
+			for(size_t v = 0; v < count; v++)
+			{
+				Uint64 coded;
+				if(!GetVarint(data, end, coded))
+					return false;
+				value = v == 0 ? coded : value + (Uint64)((Sint64)(coded >> 1) ^ -(Sint64)(coded & 1));
+				out[v] = (T)value;
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <cstddef>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnFormat.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Compresses the values of one column of one block into a chunk,
+ * and back. Values are given as 64 bit integers whatever the
+ * column width, and decoded straight into arrays of the column
+ * width, ready to be scanned.
+ * Encoding picks the smallest of the encodings in ColumnFormat.h,
+ * decoding checks every read against the chunk size, so a
+ * corrupted file fails to decode instead of crashing the reader.
+ */
+class ColumnCodec
+{
+	// Methods
+public:
+	static void Encode(const Uint64 * values, size_t count, Uint8 width, vector<Uint8> & out, ColumnChunk & chunk);
+	static bool Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint8 * out);
+	static bool Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint16 * out);
+	static bool Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint32 * out);
+	static bool Decode(const Uint8 * data, const ColumnChunk & chunk, size_t count, Uint64 * out);
+protected:
+private:
+	static void EncodePlain(const Uint64 * values, size_t count, Uint8 width, vector<Uint8> & out);
+	static void EncodeBitPack(const Uint64 * values, size_t count, Uint64 minValue, Uint8 bitWidth, vector<Uint8> & out);
+	static void EncodeRunLength(const Uint64 * values, size_t count, Uint64 minValue, vector<Uint8> & out);
+	static void EncodeDelta(const Uint64 * values, size_t count, vector<Uint8> & out);
+	static void PutVarint(vector<Uint8> & out, Uint64 value);
+	static bool GetVarint(const Uint8 * & data, const Uint8 * end, Uint64 & value);
+	template<typename T> static bool DecodeValues(const Uint8 * data, const ColumnChunk & chunk, size_t count, T * out);
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+/*
+ * Layout of a column file: game events stored column by column,
+ * in blocks of rows, each column of each block compressed on its
+ * own. A scan only reads (and decodes) the columns it needs, and
+ * skips whole blocks whose min/max can't match its filters.
+ *
+ *	[ColumnFileHeader][ColumnDescriptor x columns]
+ *	[block 0: chunk of column 0, chunk of column 1, ...]
+ *	[block 1: ...]
+ *	[padding to 8 bytes]
+ *	[directory: (ColumnBlockEntry, ColumnChunk x columns) x blocks]
+ *	[ColumnFileTrailer]
+ *
+ * The directory is written last, so files are written in one
+ * pass, and found from the trailer at the end of the file.
+ * Everything is little-endian.
+ */
+
+#pragma region Constant Parameters
+#define COLUMN_FILE_MAGIC 0x4C434B50U	//	"PKCL"
+#define COLUMN_FILE_VERSION 1
+#define COLUMN_NAME_LENGTH 12
+#define COLUMN_MAX_COLUMNS 64
+//	Rows per block: large enough to compress well, small enough to skip often
+#define COLUMN_BLOCK_ROWS 65536
+#pragma endregion
+
+/*
+ * How a chunk stores its values. The writer tries all of them
+ * and keeps the smallest output.
+ */
+enum class ColumnEncoding : Uint8
+{
+	Plain = 0,	//	Values as they are, in the column width
+	BitPack,	//	Offsets from the chunk minimum, in as few bits as the largest needs (0 for a constant)
+	RunLength,	//	(offset from the minimum, run length) varint pairs
+	Delta		//	First value, then zigzag varint differences (sorted and slowly changing columns)
+};
+
+typedef struct
+{
+	Uint32 magic;
+	Uint16 version;
+	Uint16 columnCount;
+	Uint32 blockRows;
+	Uint32 reserved;
+} ColumnFileHeader;
+
+typedef struct
+{
+	char name[COLUMN_NAME_LENGTH];	//	Zero padded, not always terminated
+	Uint8 width;					//	Bytes per value: 1, 2, 4 or 8
+	Uint8 reserved[3];
+} ColumnDescriptor;
+
+typedef struct
+{
+	Uint32 rows;
+	Uint32 reserved;
+} ColumnBlockEntry;
+
+typedef struct
+{
+	Uint64 offset;		//	From the start of the file
+	Uint32 size;		//	Compressed bytes
+	Uint8 encoding;		//	ColumnEncoding
+	Uint8 bitWidth;		//	BitPack only
+	Uint16 reserved;
+	Uint64 minValue;	//	Zone map: lets scans skip the block without decoding it
+	Uint64 maxValue;
+} ColumnChunk;
+
+typedef struct
+{
+	Uint64 directoryOffset;
+	Uint64 rowCount;
+	Uint32 blockCount;
+	Uint32 magic;
+} ColumnFileTrailer;
+
+static_assert(sizeof(ColumnFileHeader) == 16, "ColumnFileHeader layout must be the same for every build");
+static_assert(sizeof(ColumnDescriptor) == 16, "ColumnDescriptor layout must be the same for every build");
+static_assert(sizeof(ColumnBlockEntry) == 8, "ColumnBlockEntry layout must be the same for every build");
+static_assert(sizeof(ColumnChunk) == 32, "ColumnChunk layout must be the same for every build");
+static_assert(sizeof(ColumnFileTrailer) == 24, "ColumnFileTrailer layout must be the same for every build");
@@ -0,0 +1,166 @@
+#include "ColumnReader.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#pragma endregion
+
+#pragma region System Includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnCodec.h"
+#pragma endregion
+
+ColumnReader::ColumnReader() :
+	map(nullptr),
+	mapSize(0),
+	header(nullptr),
+	columns(nullptr),
+	directory(nullptr),
+	blockCount(0),
+	rowCount(0)
+{ }
+
+ColumnReader::~ColumnReader()
+{
+	Close();
+}
+
+bool ColumnReader::Open(const string & path)
+{
+	Close();
+
+	const int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return false;
+
+	struct stat info;
+	void * memory = MAP_FAILED;
+	if(fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(ColumnFileHeader) + sizeof(ColumnFileTrailer))
+		memory = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(memory == MAP_FAILED)
+		return false;
+
+	map = (const Uint8 *)memory;
+	mapSize = (size_t)info.st_size;
+
+	//	Scans read chunks one after the other, let the kernel read ahead
+	madvise(memory, mapSize, MADV_SEQUENTIAL);
+
+	//	Check the header and the trailer, then that the descriptors and the directory fit between them
+	header = (const ColumnFileHeader *)map;
+	ColumnFileTrailer trailer;
+	memcpy(&trailer, map + mapSize - sizeof(trailer), sizeof(trailer));
+	const size_t columnsEnd = sizeof(ColumnFileHeader) + header->columnCount * sizeof(ColumnDescriptor);
+	const size_t blockEntrySize = sizeof(ColumnBlockEntry) + header->columnCount * sizeof(ColumnChunk);
+	const size_t directoryEnd = mapSize - sizeof(trailer);
+	if(header->magic != COLUMN_FILE_MAGIC || header->version != COLUMN_FILE_VERSION || trailer.magic != COLUMN_FILE_MAGIC ||
+		header->columnCount < 1 || header->columnCount > COLUMN_MAX_COLUMNS || columnsEnd > directoryEnd ||
+		trailer.directoryOffset < columnsEnd || trailer.directoryOffset > directoryEnd || trailer.directoryOffset % 8 != 0 ||
+		(directoryEnd - trailer.directoryOffset) != (Uint64)trailer.blockCount * blockEntrySize)
+	{
+		Close();
+		return false;
+	}
+
+	columns = (const ColumnDescriptor *)(map + sizeof(ColumnFileHeader));
+	directory = map + trailer.directoryOffset;
+	blockCount = trailer.blockCount;
+	rowCount = trailer.rowCount;
+
+	//	Every chunk must lie within the data, so decoding never reads past the map
+	for(Uint32 b = 0; b < blockCount; b++)
+	{
+		if(GetBlockRows(b) > header->blockRows)
+		{
+			Close();
+			return false;
+		}
+		for(int c = 0; c < header->columnCount; c++)
+		{
+			const ColumnChunk & chunk = GetChunk(b, c);
+			if(chunk.offset < columnsEnd || chunk.offset > trailer.directoryOffset || chunk.size > trailer.directoryOffset - chunk.offset)
+			{
+				Close();
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void ColumnReader::Close()
+{
+	if(!map)
+		return;
+
+	munmap((void *)map, mapSize);
+	map = nullptr;
+	mapSize = 0;
+	header = nullptr;
+	columns = nullptr;
+	directory = nullptr;
+	blockCount = 0;
+	rowCount = 0;
+}
+
+int ColumnReader::FindColumn(const string & name) const
+{
+	if(name.size() > COLUMN_NAME_LENGTH)
+		return -1;
+
+	for(int c = 0; c < GetColumnCount(); c++)
+		if(strncmp(columns[c].name, name.c_str(), COLUMN_NAME_LENGTH) == 0)
+			return c;
+
+	return -1;
+}
+
+Uint32 ColumnReader::GetBlockRows(Uint32 block) const
+{
+	const size_t blockEntrySize = sizeof(ColumnBlockEntry) + header->columnCount * sizeof(ColumnChunk);
+	return ((const ColumnBlockEntry *)(directory + block * blockEntrySize))->rows;
+}
+
+const ColumnChunk & ColumnReader::GetChunk(Uint32 block, int column) const
+{
+	const size_t blockEntrySize = sizeof(ColumnBlockEntry) + header->columnCount * sizeof(ColumnChunk);
+	return ((const ColumnChunk *)(directory + block * blockEntrySize + sizeof(ColumnBlockEntry)))[column];
+}
+
+bool ColumnReader::ReadColumn(Uint32 block, int column, vector<Uint8> & out) const
+{
+	return ReadValues(block, column, out);
+}
+
+bool ColumnReader::ReadColumn(Uint32 block, int column, vector<Uint16> & out) const
+{
+	return ReadValues(block, column, out);
+}
+
+bool ColumnReader::ReadColumn(Uint32 block, int column, vector<Uint32> & out) const
+{
+	return ReadValues(block, column, out);
+}
+
+bool ColumnReader::ReadColumn(Uint32 block, int column, vector<Uint64> & out) const
+{
+	return ReadValues(block, column, out);
+}
+
+template<typename T> bool ColumnReader::ReadValues(Uint32 block, int column, vector<T> & out) const
+{
+	//	Values are decoded in the width they were written with
+	if(!map || block >= blockCount || column < 0 || column >= GetColumnCount() || columns[column].width != sizeof(T))
+		return false;
+
+	const ColumnChunk & chunk = GetChunk(block, column);
+	out.resize(GetBlockRows(block));
+	return ColumnCodec::Decode(map + chunk.offset, chunk, out.size(), out.data());
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#include <cstddef>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnFormat.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Reads a column file (see ColumnFormat.h) through a read-only
+ * memory map: opening only checks the header, the descriptors
+ * and the directory, chunks are decoded straight from the
+ * mapped pages when a scan asks for them, so untouched columns
+ * are never even read from disk.
+ * Columns are decoded a block at a time into caller-owned
+ * vectors of the column width, to be reused from one block to
+ * the next. The zone maps (min/max of each chunk) tell which
+ * blocks a filter can skip without decoding anything.
+ */
+class ColumnReader
+{
+	// Fields
+public:
+protected:
+private:
+	const Uint8 * map;
+	size_t mapSize;
+	const ColumnFileHeader * header;
+	const ColumnDescriptor * columns;
+	const Uint8 * directory;
+	Uint32 blockCount;
+	Uint64 rowCount;
+	// Constructors
+public:
+	ColumnReader();
+	~ColumnReader();
+	ColumnReader(const ColumnReader &) = delete;
+	ColumnReader & operator=(const ColumnReader &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Open(const string & path);
+	void Close();
+	__inline bool IsOpen() const { return map != nullptr; }
+	__inline size_t GetFileSize() const { return mapSize; }
+	__inline Uint64 GetRowCount() const { return rowCount; }
+	__inline Uint32 GetBlockCount() const { return blockCount; }
+	__inline int GetColumnCount() const { return header ? header->columnCount : 0; }
+	__inline const ColumnDescriptor & GetColumn(int column) const { return columns[column]; }
+	int FindColumn(const string & name) const;
+	Uint32 GetBlockRows(Uint32 block) const;
+	const ColumnChunk & GetChunk(Uint32 block, int column) const;
+	bool ReadColumn(Uint32 block, int column, vector<Uint8> & out) const;
+	bool ReadColumn(Uint32 block, int column, vector<Uint16> & out) const;
+	bool ReadColumn(Uint32 block, int column, vector<Uint32> & out) const;
+	bool ReadColumn(Uint32 block, int column, vector<Uint64> & out) const;
+protected:
+private:
+	template<typename T> bool ReadValues(Uint32 block, int column, vector<T> & out) const;
+};
@@ -0,0 +1,132 @@
+#include "ColumnScan.h"
+
+#pragma region System Includes
+#if defined(__SSE2__) || defined(_M_X64)
+#define COLUMN_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#pragma endregion
+
+//	Range test of up to 64 values into one mask word, one bit per value
+template<typename T> static __inline Uint64 RangeWord(const T * values, size_t count, T low, T high)
+{
+	Uint64 word = 0;
+	for(size_t v = 0; v < count; v++)
+		word |= (Uint64)(values[v] >= low && values[v] <= high) << v;
+	return word;
+}
+
+//	Range test of a whole word of values
+template<typename T> static __inline Uint64 RangeWord64(const T * values, T low, T high)
+{
+	return RangeWord(values, 64, low, high);
+}
+
+#ifdef COLUMN_SCAN_SSE2
+static __inline Uint64 RangeWord64(const Uint8 * values, Uint8 low, Uint8 high)
+{
+	//	Unsigned bytes: in range when max(v, low) and min(v, high) are both v
+	const __m128i lowest = _mm_set1_epi8((char)low);
+	const __m128i highest = _mm_set1_epi8((char)high);
+	Uint64 word = 0;
+	for(int lane = 0; lane < 4; lane++)
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i *)(values + lane * 16));
+		const __m128i inside = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, lowest), v), _mm_cmpeq_epi8(_mm_min_epu8(v, highest), v));
+		word |= (Uint64)(Uint16)_mm_movemask_epi8(inside) << (lane * 16);
+	}
+	return word;
+}
+
+static __inline Uint64 RangeWord64(const Uint32 * values, Uint32 low, Uint32 high)
+{
+	//	SSE2 only compares signed integers: flip the sign bits to compare unsigned ones
+	const __m128i sign = _mm_set1_epi32((int)0x80000000U);
+	const __m128i lowest = _mm_xor_si128(_mm_set1_epi32((int)low), sign);
+	const __m128i highest = _mm_xor_si128(_mm_set1_epi32((int)high), sign);
+	Uint64 word = 0;
+	for(int lane = 0; lane < 16; lane++)
+	{
+		const __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(values + lane * 4)), sign);
+		const __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lowest, v), _mm_cmpgt_epi32(v, highest));
+		word |= (Uint64)(~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF) << (lane * 4);
+	}
+	return word;
+}
+#endif
+
+//	Whole words go through the widest test available (SSE2 for bytes and 32 bit values), the tail through the plain one
+template<typename T> static void FilterValues(const T * values, size_t count, T low, T high, vector<Uint64> & mask)
+{
+	const size_t words = SDL_min(mask.size(), (count + 63) / 64);
+	for(size_t w = 0; w < words; w++)
+	{
+		//	Rows already filtered out don't need testing
+		if(mask[w] == 0)
+			continue;
+
+		const T * wordValues = values + w * 64;
+		const size_t wordCount = SDL_min(count - w * 64, (size_t)64);
+		mask[w] &= wordCount == 64 ? RangeWord64(wordValues, low, high) : RangeWord(wordValues, wordCount, low, high);
+	}
+}
+
+void ColumnScan::SelectAll(size_t count, vector<Uint64> & mask)
+{
+	mask.assign((count + 63) / 64, ~0ULL);
+	if(count % 64 != 0)
+		mask.back() = (1ULL << (count % 64)) - 1;
+}
+
+void ColumnScan::Filter(const Uint8 * values, size_t count, Uint8 low, Uint8 high, vector<Uint64> & mask)
+{
+	FilterValues(values, count, low, high, mask);
+}
+
+void ColumnScan::Filter(const Uint16 * values, size_t count, Uint16 low, Uint16 high, vector<Uint64> & mask)
+{
+	FilterValues(values, count, low, high, mask);
+}
+
+void ColumnScan::Filter(const Uint32 * values, size_t count, Uint32 low, Uint32 high, vector<Uint64> & mask)
+{
+	FilterValues(values, count, low, high, mask);
+}
+
+void ColumnScan::Filter(const Uint64 * values, size_t count, Uint64 low, Uint64 high, vector<Uint64> & mask)
+{
+	FilterValues(values, count, low, high, mask);
+}
+
+void ColumnScan::Intersect(const vector<Uint64> & mask, const vector<Uint64> & other, vector<Uint64> & out)
+{
+	out.resize(SDL_min(mask.size(), other.size()));
+	for(size_t w = 0; w < out.size(); w++)
+		out[w] = mask[w] & other[w];
+}
+
+Uint64 ColumnScan::Count(const vector<Uint64> & mask)
+{
+	Uint64 count = 0;
+	for(const Uint64 & word : mask)
+#ifdef _MSC_VER
+		count += __popcnt64(word);
+#else
+		count += __builtin_popcountll(word);
+#endif
+	return count;
+}
+
+int ColumnScan::LowestBit(Uint64 word)
+{
+#ifdef _MSC_VER
+	unsigned long bit;
+	_BitScanForward64(&bit, word);
+	return (int)bit;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <cstddef>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Filters over decoded column values, a block at a time.
+ * A selection is a bit mask, one bit per row and 64 rows per
+ * word: filters narrow it down (a range test on one column,
+ * ANDed into the mask), aggregates count its bits or visit the
+ * selected rows only. Range tests compare 16 bytes at a time
+ * with SSE2 where available, other targets use a branch-free
+ * loop the compiler can vectorize on its own.
+ */
+class ColumnScan
+{
+	// Methods
+public:
+	static void SelectAll(size_t count, vector<Uint64> & mask);
+	static void Filter(const Uint8 * values, size_t count, Uint8 low, Uint8 high, vector<Uint64> & mask);
+	static void Filter(const Uint16 * values, size_t count, Uint16 low, Uint16 high, vector<Uint64> & mask);
+	static void Filter(const Uint32 * values, size_t count, Uint32 low, Uint32 high, vector<Uint64> & mask);
+	static void Filter(const Uint64 * values, size_t count, Uint64 low, Uint64 high, vector<Uint64> & mask);
+	static void Intersect(const vector<Uint64> & mask, const vector<Uint64> & other, vector<Uint64> & out);
+	static Uint64 Count(const vector<Uint64> & mask);
+	template<typename Visitor> static void ForEach(const vector<Uint64> & mask, Visitor visit);
+protected:
+private:
+	static int LowestBit(Uint64 word);
+};
+
+template<typename Visitor> void ColumnScan::ForEach(const vector<Uint64> & mask, Visitor visit)
+{
+	for(size_t w = 0; w < mask.size(); w++)
+		for(Uint64 word = mask[w]; word != 0; word &= word - 1)
+			visit(w * 64 + LowestBit(word));
+}
@@ -0,0 +1,130 @@
+#include "ColumnWriter.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnCodec.h"
+#pragma endregion
+
+ColumnWriter::ColumnWriter() :
+	file(nullptr),
+	blockRows(COLUMN_BLOCK_ROWS),
+	offset(0),
+	rowCount(0),
+	failed(false)
+{ }
+
+ColumnWriter::~ColumnWriter()
+{
+	Close();
+}
+
+bool ColumnWriter::Open(const string & path, const vector<ColumnDescriptor> & fileColumns, Uint32 rowsPerBlock)
+{
+	Close();
+
+	if(fileColumns.empty() || fileColumns.size() > COLUMN_MAX_COLUMNS || rowsPerBlock < 1)
+		return false;
+	for(const ColumnDescriptor & column : fileColumns)
+		if(column.width != 1 && column.width != 2 && column.width != 4 && column.width != 8)
+			return false;
+
+	file = fopen(path.c_str(), "wb");
+	if(!file)
+		return false;
+
+	columns = fileColumns;
+	values.assign(columns.size(), vector<Uint64>());
+	for(vector<Uint64> & column : values)
+		column.reserve(rowsPerBlock);
+	blocks.clear();
+	chunks.clear();
+	blockRows = rowsPerBlock;
+	offset = 0;
+	rowCount = 0;
+	failed = false;
+
+	ColumnFileHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = COLUMN_FILE_MAGIC;
+	header.version = COLUMN_FILE_VERSION;
+	header.columnCount = (Uint16)columns.size();
+	header.blockRows = blockRows;
+	Write(&header, sizeof(header));
+	Write(columns.data(), columns.size() * sizeof(ColumnDescriptor));
+
+	return !failed;
+}
+
+void ColumnWriter::Append(const Uint64 * row)
+{
+	if(!file)
+		return;
+
+	for(size_t c = 0; c < columns.size(); c++)
+		values[c].push_back(row[c]);
+	rowCount++;
+
+	if(values[0].size() >= blockRows)
+		WriteBlock();
+}
+
+bool ColumnWriter::Close()
+{
+	if(!file)
+		return false;
+
+	//	Last (partial) block, then the directory to find them all (aligned, readers map it in place)
+	if(!values[0].empty())
+		WriteBlock();
+	const Uint8 padding[8] = {0};
+	Write(padding, (8 - offset % 8) % 8);
+
+	ColumnFileTrailer trailer;
+	memset(&trailer, 0, sizeof(trailer));
+	trailer.directoryOffset = offset;
+	trailer.rowCount = rowCount;
+	trailer.blockCount = (Uint32)blocks.size();
+	trailer.magic = COLUMN_FILE_MAGIC;
+	for(size_t b = 0; b < blocks.size(); b++)
+	{
+		Write(&blocks[b], sizeof(ColumnBlockEntry));
+		Write(&chunks[b * columns.size()], columns.size() * sizeof(ColumnChunk));
+	}
+	Write(&trailer, sizeof(trailer));
+
+	if(fclose(file) != 0)
+		failed = true;
+	file = nullptr;
+
+	return !failed;
+}
+
+void ColumnWriter::WriteBlock()
+{
+	ColumnBlockEntry block;
+	memset(&block, 0, sizeof(block));
+	block.rows = (Uint32)values[0].size();
+	blocks.push_back(block);
+
+	for(size_t c = 0; c < columns.size(); c++)
+	{
+		ColumnChunk chunk;
+		ColumnCodec::Encode(values[c].data(), values[c].size(), columns[c].width, encoded, chunk);
+		chunk.offset = offset;
+		chunk.size = (Uint32)encoded.size();
+		chunks.push_back(chunk);
+
+		Write(encoded.data(), encoded.size());
+		values[c].clear();
+	}
+}
+
+void ColumnWriter::Write(const void * data, size_t size)
+{
+	if(size > 0 && fwrite(data, 1, size, file) != size)
+		failed = true;
+	offset += size;
+}
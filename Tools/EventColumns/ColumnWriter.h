@@ -0,0 +1,64 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#include <cstdio>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnFormat.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Writes a column file (see ColumnFormat.h) in one pass.
+ * Rows are appended one at a time, a value per column, and kept
+ * until a block is full: then every column of the block is
+ * compressed and written, and the buffers start over. The
+ * directory and the trailer are written by Close, a file that
+ * wasn't closed has no trailer and is refused by readers.
+ */
+class ColumnWriter
+{
+	// Fields
+public:
+protected:
+private:
+	FILE * file;
+	vector<ColumnDescriptor> columns;
+	vector<vector<Uint64>> values;
+	vector<ColumnBlockEntry> blocks;
+	vector<ColumnChunk> chunks;
+	vector<Uint8> encoded;
+	Uint32 blockRows;
+	Uint64 offset;
+	Uint64 rowCount;
+	bool failed;
+	// Constructors
+public:
+	ColumnWriter();
+	~ColumnWriter();
+	ColumnWriter(const ColumnWriter &) = delete;
+	ColumnWriter & operator=(const ColumnWriter &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Open(const string & path, const vector<ColumnDescriptor> & fileColumns, Uint32 rowsPerBlock = COLUMN_BLOCK_ROWS);
+	void Append(const Uint64 * row);
+	bool Close();
+	__inline bool IsOpen() const { return file != nullptr; }
+	__inline Uint64 GetRowCount() const { return rowCount; }
+	__inline Uint64 GetSize() const { return offset; }
+protected:
+private:
+	void WriteBlock();
+	void Write(const void * data, size_t size);
+};
@@ -0,0 +1,39 @@
+#include "EventSchema.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#pragma endregion
+
+vector<ColumnDescriptor> EventSchema::GetColumns()
+{
+	vector<ColumnDescriptor> columns(EVENT_COLUMNS);
+	for(int c = 0; c < EVENT_COLUMNS; c++)
+	{
+		ColumnDescriptor & column = columns[c];
+		memset(&column, 0, sizeof(column));
+		const string name = GetName(c);
+		memcpy(column.name, name.data(), SDL_min(name.size(), (size_t)COLUMN_NAME_LENGTH));
+
+		switch(c)
+		{
+			case EVENT_TIME: column.width = 8; break;
+			case EVENT_SESSION: case EVENT_TIME_LEFT: case EVENT_STAGE_TIME: column.width = 4; break;
+			default: column.width = c >= EVENT_INPUTS ? sizeof(CharIndex) : 1; break;
+		}
+	}
+
+	return columns;
+}
+
+string EventSchema::GetName(int column)
+{
+	static const char * names[] = {"time", "session", "type", "stage", "stagesLeft", "timeLeft", "stageTime", "codeLength", "flags"};
+
+	if(column >= 0 && column < EVENT_ERRORS)
+		return names[column];
+	if(column >= EVENT_ERRORS && column < EVENT_INPUTS)
+		return "error" + to_string(column - EVENT_ERRORS);
+	if(column >= EVENT_INPUTS && column < EVENT_COLUMNS)
+		return "input" + to_string(column - EVENT_INPUTS);
+	return "";
+}
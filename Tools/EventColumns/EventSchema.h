@@ -0,0 +1,49 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region Game Includes
+#include "TelemetryLog.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnFormat.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * The columns of a game event file: one row per telemetry record
+ * (see TelemetryLog.h), with absolute times, sessions numbered
+ * across all the converted runs and the stage each event belongs
+ * to, so reports never need to replay sessions.
+ * Digit errors and inputs get a column per digit, only filled up
+ * to the code length: columns beyond it are constant and cost
+ * next to nothing once compressed.
+ */
+enum EventColumn
+{
+	EVENT_TIME = 0,		//	Unix time in milliseconds
+	EVENT_SESSION,		//	Unique in the file
+	EVENT_TYPE,			//	TelemetryEvent
+	EVENT_STAGE,		//	1 based, the stage being played (or just cleared)
+	EVENT_STAGES_LEFT,
+	EVENT_TIME_LEFT,	//	Milliseconds left to the end of the game
+	EVENT_STAGE_TIME,	//	Milliseconds since the stage began
+	EVENT_CODE_LENGTH,
+	EVENT_FLAGS,		//	TELEMETRY_FLAG_*
+	EVENT_ERRORS,		//	First digit error column, one per digit
+	EVENT_INPUTS = EVENT_ERRORS + TELEMETRY_MAX_CODE,	//	First input column (charset slots), one per digit
+	EVENT_COLUMNS = EVENT_INPUTS + TELEMETRY_MAX_CODE
+};
+
+class EventSchema
+{
+	// Methods
+public:
+	static vector<ColumnDescriptor> GetColumns();
+	static string GetName(int column);
+};
@@ -0,0 +1,228 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#pragma endregion
+
+#pragma region Game Includes
+#include "TelemetryLog.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnWriter.h"
+#include "EventSchema.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Converts the event logs the game writes with --telemetry into
+ * one column file (see ColumnFormat.h) for EventReport.
+ * Logs are read record by record, once: each run in them (a
+ * header, then its records) gets its sessions renumbered so they
+ * stay unique across runs and files, and every event gets its
+ * absolute time and the stage it belongs to.
+ */
+
+#pragma region Constant Parameters
+//	Records buffered from a log at a time
+#define CONVERT_BATCH 4096
+#pragma endregion
+
+typedef struct
+{
+	Uint32 id;			//	In the column file
+	Uint8 stage;
+	Uint64 stageStart;
+} SessionProgress;
+
+typedef struct
+{
+	Uint64 runs;
+	Uint64 records;
+	Uint64 sessions;
+	Uint64 inputBytes;
+} ConvertStats;
+
+//	Headers can't be confused with records: a record starting with the magic would be 49 days into its run
+static __inline bool IsHeader(const Uint8 * data)
+{
+	TelemetryFileHeader header;
+	memcpy(&header, data, sizeof(header));
+	return header.magic == TELEMETRY_MAGIC && (header.version != 0 || header.recordSize != 0);
+}
+
+static bool ConvertLog(const string & path, ColumnWriter & writer, ConvertStats & stats)
+{
+	FILE * log = fopen(path.c_str(), "rb");
+	if(!log)
+	{
+		cout << "Cannot read " << path << endl;
+		return false;
+	}
+
+	unordered_map<Uint32, SessionProgress> sessions;
+	vector<Uint8> buffer(CONVERT_BATCH * sizeof(TelemetryRecord));
+	size_t position = 0;
+	size_t available = 0;
+	Uint64 row[EVENT_COLUMNS];
+	Uint64 startTime = 0;
+	bool inRun = false;
+	bool valid = true;
+	for(;;)
+	{
+		//	Keep at least a whole record in the buffer, until the log ends
+		if(available - position < sizeof(TelemetryRecord))
+		{
+			memmove(buffer.data(), buffer.data() + position, available - position);
+			available -= position;
+			position = 0;
+			available += fread(buffer.data() + available, 1, buffer.size() - available, log);
+		}
+		const size_t left = available - position;
+		if(left == 0)
+			break;
+
+		//	A run starts with a header, then its records follow
+		const Uint8 * data = buffer.data() + position;
+		if(left >= sizeof(TelemetryFileHeader) && IsHeader(data))
+		{
+			TelemetryFileHeader header;
+			memcpy(&header, data, sizeof(header));
+			if(header.version != TELEMETRY_VERSION || header.recordSize != sizeof(TelemetryRecord))
+			{
+				cout << path << ": unsupported telemetry version " << header.version << endl;
+				valid = false;
+				break;
+			}
+			startTime = header.startTime;
+			sessions.clear();
+			inRun = true;
+			stats.runs++;
+			stats.inputBytes += sizeof(header);
+			position += sizeof(header);
+			continue;
+		}
+		if(!inRun)
+		{
+			cout << path << ": not a telemetry log" << endl;
+			valid = false;
+			break;
+		}
+
+		//	A log cut short (the game was killed while writing) ends with part of a record
+		if(left < sizeof(TelemetryRecord))
+		{
+			cout << path << ": ignoring an incomplete record at the end" << endl;
+			break;
+		}
+
+		TelemetryRecord record;
+		memcpy(&record, data, sizeof(record));
+		position += sizeof(record);
+		stats.inputBytes += sizeof(record);
+		const Uint64 time = startTime + record.time;
+
+		//	Sessions begin with GameStart, records of sessions whose start was lost begin them too
+		const bool known = sessions.count(record.session) > 0;
+		SessionProgress & progress = sessions[record.session];
+		if(!known || record.type == (Uint8)TelemetryEvent::GameStart)
+		{
+			progress.id = (Uint32)stats.sessions++;
+			progress.stage = 1;
+			progress.stageStart = time;
+		}
+
+		memset(row, 0, sizeof(row));
+		row[EVENT_TIME] = time;
+		row[EVENT_SESSION] = progress.id;
+		row[EVENT_TYPE] = record.type;
+		row[EVENT_STAGE] = progress.stage;
+		row[EVENT_STAGES_LEFT] = record.stagesLeft;
+		row[EVENT_TIME_LEFT] = record.timeLeft;
+		row[EVENT_STAGE_TIME] = SDL_min(time - progress.stageStart, (Uint64)0xFFFFFFFFU);
+		row[EVENT_CODE_LENGTH] = record.codeLength;
+		row[EVENT_FLAGS] = record.flags;
+		for(int d = 0; d < record.codeLength && d < TELEMETRY_MAX_CODE; d++)
+		{
+			row[EVENT_ERRORS + d] = record.digitErrors[d];
+			row[EVENT_INPUTS + d] = record.input[d];
+		}
+		writer.Append(row);
+		stats.records++;
+
+		//	The next stage begins as soon as this one is cleared
+		if(record.type == (Uint8)TelemetryEvent::StageCleared)
+		{
+			progress.stage++;
+			progress.stageStart = time;
+		}
+	}
+
+	fclose(log);
+	return valid;
+}
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	string outputPath;
+	vector<string> inputPaths;
+	Uint32 blockRows = COLUMN_BLOCK_ROWS;
+	bool usage = false;
+
+	for(int a = 1; a < argc; a++)
+	{
+		const string arg = argv[a];
+		if(arg == "--block-rows" && a + 1 < argc)
+			blockRows = (Uint32)atoi(argv[++a]);
+		else if(arg.compare(0, 2, "--") == 0)
+			usage = true;
+		else if(outputPath.empty())
+			outputPath = arg;
+		else
+			inputPaths.push_back(arg);
+	}
+	if(usage || inputPaths.empty() || blockRows < 64)
+	{
+		cout << "Usage: EventConvert [--block-rows N] OUTPUT LOG..." << endl;
+		cout << "  Converts the logs written by the game with --telemetry into one column file for EventReport" << endl;
+		return 1;
+	}
+
+	ColumnWriter writer;
+	if(!writer.Open(outputPath, EventSchema::GetColumns(), blockRows))
+	{
+		cout << "Cannot write " << outputPath << endl;
+		return 1;
+	}
+
+	const steady_clock::time_point start = steady_clock::now();
+	ConvertStats stats;
+	memset(&stats, 0, sizeof(stats));
+	bool converted = true;
+	for(const string & path : inputPaths)
+		converted = ConvertLog(path, writer, stats) && converted;
+	if(!writer.Close())
+	{
+		cout << "Cannot write " << outputPath << endl;
+		return 1;
+	}
+	const double seconds = duration<double>(steady_clock::now() - start).count();
+
+	cout << fixed << setprecision(2);
+	cout << stats.records << " events, " << stats.sessions << " sessions from " << stats.runs << " runs in " << seconds << " s" << endl;
+	cout << stats.inputBytes / 1024.0 << " KB of logs into " << writer.GetSize() / 1024.0 << " KB of columns";
+	if(writer.GetSize() > 0)
+		cout << " (" << (double)stats.inputBytes / writer.GetSize() << "x smaller)";
+	cout << endl;
+
+	return converted ? 0 : 1;
+}
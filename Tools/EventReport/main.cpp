@@ -0,0 +1,334 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#pragma endregion
+
+#pragma region Game Includes
+#include "SharedState.h"
+#include "TelemetryLog.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "ColumnReader.h"
+#include "ColumnScan.h"
+#include "EventSchema.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Offline analytics over the column files written by
+ * EventConvert: how long players take to clear each stage
+ * (median and 90th percentile) and how the hint colors of their
+ * submissions are distributed, digit by digit.
+ * Files are memory mapped and scanned a block at a time, only
+ * decoding the columns a report needs: the zone maps skip blocks
+ * no row of which can match, and filters narrow a bit mask of
+ * the rows with vectorized range tests before anything is
+ * aggregated.
+ */
+
+typedef struct
+{
+	Uint8 minCodeLength;
+	Uint8 maxCodeLength;
+	Uint64 from;	//	Unix time in milliseconds
+	Uint64 to;
+} ReportFilters;
+
+typedef struct
+{
+	map<Uint8, vector<Uint32>> stageTimes;
+	Uint64 correct[TELEMETRY_MAX_CODE];
+	Uint64 close[TELEMETRY_MAX_CODE];
+	Uint64 digits[TELEMETRY_MAX_CODE];
+	Uint64 submissions;
+	Uint64 matches;
+	Uint64 won;
+	Uint64 lost;
+	Uint64 rows;
+	Uint64 blocks;
+	Uint64 skippedBlocks;
+	Uint64 decodedBytes;
+} ReportTotals;
+
+/*
+ * Decoded columns of the current block, reused from one block
+ * to the next so scanning never allocates after the first one.
+ */
+typedef struct
+{
+	vector<Uint8> type;
+	vector<Uint8> stage;
+	vector<Uint8> codeLength;
+	vector<Uint8> flags;
+	vector<Uint8> error;
+	vector<Uint32> stageTime;
+	vector<Uint64> time;
+	vector<Uint64> rows;		//	Rows matching the filters
+	vector<Uint64> selected;	//	Rows a report aggregates
+	vector<Uint64> digit;
+	vector<Uint64> hint;
+} ScanBuffers;
+
+/*
+ * Narrows the rows of a block to the values of a column within
+ * [low, high]. Returns false if the zone map says no row can
+ * match, without decoding anything; when it says every row
+ * matches, nothing is decoded either.
+ */
+template<typename T> static bool ApplyFilter(const ColumnReader & reader, Uint32 block, int column, T low, T high, vector<T> & values, vector<Uint64> & mask, ReportTotals & totals)
+{
+	const ColumnChunk & chunk = reader.GetChunk(block, column);
+	if(chunk.maxValue < low || chunk.minValue > high)
+		return false;
+	if(chunk.minValue >= low && chunk.maxValue <= high)
+		return true;
+
+	if(!reader.ReadColumn(block, column, values))
+	{
+		cout << "Skipping block " << block << ": cannot decode its " << reader.GetColumn(column).width * 8 << " bit column " << column << endl;
+		return false;
+	}
+	totals.decodedBytes += chunk.size;
+	ColumnScan::Filter(values.data(), values.size(), low, high, mask);
+	return true;
+}
+
+//	Decodes a whole column of a block, for aggregates
+template<typename T> static bool DecodeColumn(const ColumnReader & reader, Uint32 block, int column, vector<T> & values, ReportTotals & totals)
+{
+	totals.decodedBytes += reader.GetChunk(block, column).size;
+	return reader.ReadColumn(block, column, values);
+}
+
+//	Counts the rows of a selection with a value within [low, high], leaving them selected in another mask
+static Uint64 CountWithin(const vector<Uint8> & values, Uint8 low, Uint8 high, const vector<Uint64> & from, vector<Uint64> & into)
+{
+	into = from;
+	ColumnScan::Filter(values.data(), values.size(), low, high, into);
+	return ColumnScan::Count(into);
+}
+
+static void GetHintErrors(const Uint8 hint, Uint8 & low, Uint8 & high)
+{
+	//	Hints only grow worse with the error, so each one covers a single range of errors
+	low = 0xFF;
+	high = 0;
+	for(int error = 0; error <= 0xFF; error++)
+		if(GetDigitHint((Uint8)error) == hint)
+		{
+			low = SDL_min(low, (Uint8)error);
+			high = (Uint8)error;
+		}
+}
+
+static bool ScanFile(const string & path, const ReportFilters & filters, ReportTotals & totals, ScanBuffers & buffers)
+{
+	ColumnReader reader;
+	if(!reader.Open(path))
+	{
+		cout << "Cannot read " << path << " (not a column file from EventConvert?)" << endl;
+		return false;
+	}
+
+	//	Find the columns by name, files don't need to have them in the same order
+	int columns[EVENT_COLUMNS];
+	for(int c = 0; c < EVENT_COLUMNS; c++)
+	{
+		columns[c] = reader.FindColumn(EventSchema::GetName(c));
+		if(columns[c] < 0 || reader.GetColumn(columns[c]).width != EventSchema::GetColumns()[c].width)
+		{
+			cout << path << ": column " << EventSchema::GetName(c) << " is missing" << endl;
+			return false;
+		}
+	}
+
+	const Uint8 submission = (Uint8)TelemetryEvent::Submission;
+	const Uint8 stageCleared = (Uint8)TelemetryEvent::StageCleared;
+	const Uint8 gameWon = (Uint8)TelemetryEvent::GameWon;
+	const Uint8 gameLost = (Uint8)TelemetryEvent::GameLost;
+	Uint8 correctLow, correctHigh, closeLow, closeHigh;
+	GetHintErrors(SHARED_HINT_CORRECT, correctLow, correctHigh);
+	GetHintErrors(SHARED_HINT_CLOSE, closeLow, closeHigh);
+	for(Uint32 b = 0; b < reader.GetBlockCount(); b++)
+	{
+		const Uint32 rows = reader.GetBlockRows(b);
+		totals.blocks++;
+
+		//	Filters common to every report first, most blocks out of a time range are skipped right here
+		ColumnScan::SelectAll(rows, buffers.rows);
+		if(!ApplyFilter(reader, b, columns[EVENT_TIME], filters.from, filters.to, buffers.time, buffers.rows, totals) ||
+			!ApplyFilter(reader, b, columns[EVENT_CODE_LENGTH], filters.minCodeLength, filters.maxCodeLength, buffers.codeLength, buffers.rows, totals))
+		{
+			totals.skippedBlocks++;
+			continue;
+		}
+		totals.rows += rows;
+
+		//	Event types of every row, all reports split on them
+		if(!DecodeColumn(reader, b, columns[EVENT_TYPE], buffers.type, totals))
+			return false;
+		totals.won += CountWithin(buffers.type, gameWon, gameWon, buffers.rows, buffers.selected);
+		totals.lost += CountWithin(buffers.type, gameLost, gameLost, buffers.rows, buffers.selected);
+
+		//	Time to clear each stage
+		if(CountWithin(buffers.type, stageCleared, stageCleared, buffers.rows, buffers.selected) > 0)
+		{
+			if(!DecodeColumn(reader, b, columns[EVENT_STAGE], buffers.stage, totals) || !DecodeColumn(reader, b, columns[EVENT_STAGE_TIME], buffers.stageTime, totals))
+				return false;
+			ColumnScan::ForEach(buffers.selected, [&](size_t row)
+			{
+				totals.stageTimes[buffers.stage[row]].push_back(buffers.stageTime[row]);
+			});
+		}
+
+		//	Hint colors of the submissions, digit by digit: only decode the digits the block has codes for
+		const Uint64 submissions = CountWithin(buffers.type, submission, submission, buffers.rows, buffers.selected);
+		if(submissions < 1)
+			continue;
+		totals.submissions += submissions;
+
+		//	The match flag is the only one so far, flagged submissions are right codes
+		if(!DecodeColumn(reader, b, columns[EVENT_FLAGS], buffers.flags, totals))
+			return false;
+		totals.matches += CountWithin(buffers.flags, TELEMETRY_FLAG_MATCH, 0xFF, buffers.selected, buffers.digit);
+
+		if(!DecodeColumn(reader, b, columns[EVENT_CODE_LENGTH], buffers.codeLength, totals))
+			return false;
+		const int maxDigits = (int)SDL_min(reader.GetChunk(b, columns[EVENT_CODE_LENGTH]).maxValue, (Uint64)TELEMETRY_MAX_CODE);
+		for(int d = 0; d < maxDigits; d++)
+		{
+			//	Submissions with a code long enough to have this digit
+			totals.digits[d] += CountWithin(buffers.codeLength, (Uint8)(d + 1), 0xFF, buffers.selected, buffers.digit);
+
+			if(!DecodeColumn(reader, b, columns[EVENT_ERRORS + d], buffers.error, totals))
+				return false;
+			totals.correct[d] += CountWithin(buffers.error, correctLow, correctHigh, buffers.digit, buffers.hint);
+			totals.close[d] += CountWithin(buffers.error, closeLow, closeHigh, buffers.digit, buffers.hint);
+		}
+	}
+
+	return true;
+}
+
+static void PrintStageTimes(map<Uint8, vector<Uint32>> & stageTimes)
+{
+	cout << endl << "Time to clear each stage" << endl;
+	cout << setw(8) << "stage" << setw(12) << "clears" << setw(12) << "median" << setw(12) << "90%" << endl;
+	for(auto & stage : stageTimes)
+	{
+		//	Partial sorts are enough for a couple of percentiles
+		vector<Uint32> & times = stage.second;
+		const size_t median = times.size() / 2;
+		const size_t slow = times.size() * 9 / 10;
+		nth_element(times.begin(), times.begin() + median, times.end());
+		const Uint32 medianTime = times[median];
+		nth_element(times.begin() + median, times.begin() + slow, times.end());
+
+		cout << setw(8) << (int)stage.first << setw(12) << times.size()
+			<< setw(10) << medianTime / 1000.0 << " s" << setw(10) << times[slow] / 1000.0 << " s" << endl;
+	}
+	if(stageTimes.empty())
+		cout << setw(8) << "-" << endl;
+}
+
+static void PrintHints(const ReportTotals & totals)
+{
+	cout << endl << "Hint colors of " << totals.submissions << " submissions (" << totals.matches << " right codes)" << endl;
+	cout << setw(8) << "digit" << setw(12) << "correct" << setw(12) << "close" << setw(12) << "wrong" << endl;
+
+	Uint64 digits = 0;
+	Uint64 correct = 0;
+	Uint64 close = 0;
+	for(int d = 0; d <= TELEMETRY_MAX_CODE; d++)
+	{
+		//	A line per digit position, then all of them together
+		const bool all = d == TELEMETRY_MAX_CODE;
+		const Uint64 digitCount = all ? digits : totals.digits[d];
+		const Uint64 correctCount = all ? correct : totals.correct[d];
+		const Uint64 closeCount = all ? close : totals.close[d];
+		if(digitCount < 1)
+			continue;
+
+		if(all)
+			cout << setw(8) << "all";
+		else
+			cout << setw(8) << d + 1;
+		cout << setw(11) << 100.0 * correctCount / digitCount << "%"
+			<< setw(11) << 100.0 * closeCount / digitCount << "%"
+			<< setw(11) << 100.0 * (digitCount - correctCount - closeCount) / digitCount << "%" << endl;
+
+		digits += digitCount;
+		correct += correctCount;
+		close += closeCount;
+	}
+}
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	ReportFilters filters;
+	filters.minCodeLength = 0;
+	filters.maxCodeLength = 0xFF;
+	filters.from = 0;
+	filters.to = ~0ULL;
+	vector<string> paths;
+	bool usage = false;
+
+	for(int a = 1; a < argc; a++)
+	{
+		const string arg = argv[a];
+		if(arg == "--code-length" && a + 1 < argc)
+			filters.minCodeLength = filters.maxCodeLength = (Uint8)atoi(argv[++a]);
+		else if(arg == "--from" && a + 1 < argc)
+			filters.from = strtoull(argv[++a], nullptr, 10);
+		else if(arg == "--to" && a + 1 < argc)
+			filters.to = strtoull(argv[++a], nullptr, 10);
+		else if(arg.compare(0, 2, "--") == 0)
+			usage = true;
+		else
+			paths.push_back(arg);
+	}
+	if(usage || paths.empty())
+	{
+		cout << "Usage: EventReport [--code-length N] [--from UNIX_MS] [--to UNIX_MS] FILE..." << endl;
+		cout << "  Reports stage clear times and hint colors from the column files written by EventConvert" << endl;
+		return 1;
+	}
+
+	ReportTotals totals;
+	memset(totals.correct, 0, sizeof(totals.correct));
+	memset(totals.close, 0, sizeof(totals.close));
+	memset(totals.digits, 0, sizeof(totals.digits));
+	totals.submissions = totals.matches = totals.won = totals.lost = 0;
+	totals.rows = totals.blocks = totals.skippedBlocks = totals.decodedBytes = 0;
+
+	const steady_clock::time_point start = steady_clock::now();
+	ScanBuffers buffers;
+	bool scanned = true;
+	for(const string & path : paths)
+		scanned = ScanFile(path, filters, totals, buffers) && scanned;
+	const double seconds = duration<double>(steady_clock::now() - start).count();
+
+	cout << fixed << setprecision(1);
+	cout << "Scanned " << totals.rows << " events in " << totals.blocks - totals.skippedBlocks << " blocks (" << totals.skippedBlocks << " skipped), "
+		<< totals.decodedBytes / 1024.0 << " KB decoded in " << seconds * 1000.0 << " ms";
+	if(seconds > 0.0)
+		cout << " (" << totals.rows / seconds / 1000000.0 << " M events/s)";
+	cout << endl;
+	cout << "Games: " << totals.won << " won, " << totals.lost << " lost" << endl;
+
+	PrintStageTimes(totals.stageTimes);
+	PrintHints(totals);
+
+	return scanned ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#pragma endregion
+
+#pragma region Game Includes
+#include "JobSystem.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Job system scaling benchmark.
+ * Runs the same fine-grained workloads with 1 to N threads
+ * (the main thread plus N - 1 workers) and prints time,
+ * throughput and speedup relative to a single thread.
+ * Two workloads are measured:
+ * - parallel for: a flat range split in small chunks
+ * - job tree: each job spawns two children down to a given
+ *   depth, so most jobs are created by workers and must be
+ *   stolen to spread across cores
+ */
+
+#pragma region Constant Parameters
+#define DEFAULT_ITEMS (1 << 22)
+#define DEFAULT_GRAIN 256
+#define DEFAULT_TREE_DEPTH 17
+#define DEFAULT_REPEATS 5
+//	Iterations of busy work per item, roughly a few nanoseconds each
+#define WORK_PER_ITEM 16
+#pragma endregion
+
+#pragma region Workloads
+/*
+ * Some arithmetic the compiler can't fold away, standing in
+ * for real per-item work (a glyph, a particle, a simulated game).
+ */
+static __inline unsigned int BusyWork(unsigned int seed, int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+		seed = seed * 1664525u + 1013904223u;
+	return seed;
+}
+
+typedef struct
+{
+	JobSystem * system;
+	Job * root;
+	atomic<unsigned int> * sink;
+	int depth;
+	int leafWork;
+} TreeNode;
+
+static void RunTreeNode(const TreeNode & node)
+{
+	//	Spawn two children until the leaves, all hanging from the same root
+	if(node.depth > 0)
+	{
+		TreeNode child = node;
+		child.depth--;
+		node.system->Run(node.system->Create([child]() { RunTreeNode(child); }, node.root));
+		node.system->Run(node.system->Create([child]() { RunTreeNode(child); }, node.root));
+		return;
+	}
+
+	node.sink->fetch_add(BusyWork((unsigned int)node.depth, node.leafWork), memory_order_relaxed);
+}
+
+static double MeasureParallelFor(JobSystem & system, int items, int grain, atomic<unsigned int> & sink)
+{
+	steady_clock::time_point start = steady_clock::now();
+
+	system.ParallelFor(items, grain, [&sink](int begin, int end)
+	{
+		unsigned int local = 0;
+		for(int i = begin; i < end; i++)
+			local += BusyWork((unsigned int)i, WORK_PER_ITEM);
+		sink.fetch_add(local, memory_order_relaxed);
+	});
+
+	return duration_cast<duration<double>>(steady_clock::now() - start).count();
+}
+
+static double MeasureTree(JobSystem & system, int depth, atomic<unsigned int> & sink)
+{
+	steady_clock::time_point start = steady_clock::now();
+
+	Job * root = system.Create([]() { });
+	TreeNode node = {&system, root, &sink, depth, WORK_PER_ITEM * 8};
+	system.Run(system.Create([node]() { RunTreeNode(node); }, root));
+	system.Run(root);
+	system.Wait(root);
+
+	return duration_cast<duration<double>>(steady_clock::now() - start).count();
+}
+#pragma endregion
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	int maxThreads = (int)thread::hardware_concurrency();
+	int items = DEFAULT_ITEMS;
+	int grain = DEFAULT_GRAIN;
+	int depth = DEFAULT_TREE_DEPTH;
+	int repeats = DEFAULT_REPEATS;
+
+	for(int a = 1; a + 1 < argc; a += 2)
+	{
+		const string arg = argv[a];
+		const int value = atoi(argv[a + 1]);
+		if(arg == "--threads")
+			maxThreads = value;
+		else if(arg == "--items")
+			items = value;
+		else if(arg == "--grain")
+			grain = value;
+		else if(arg == "--depth")
+			depth = value;
+		else if(arg == "--repeats")
+			repeats = value;
+		else
+		{
+			cout << "Usage: JobBenchmark [--threads N] [--items N] [--grain N] [--depth N] [--repeats N]" << endl;
+			return 1;
+		}
+	}
+	if(maxThreads < 1)
+		maxThreads = 1;
+	if(repeats < 1)
+		repeats = 1;
+
+	const int rangeJobs = (items + grain - 1) / grain;
+	const int treeJobs = (1 << (depth + 1)) - 1;
+	cout << "parallel for: " << items << " items, grain " << grain << " (~" << rangeJobs << " leaf jobs)" << endl;
+	cout << "job tree: depth " << depth << " (" << treeJobs << " jobs)" << endl;
+	cout << "best of " << repeats << " runs" << endl << endl;
+
+	cout << setw(8) << "threads"
+		<< setw(14) << "for (ms)" << setw(12) << "Mjobs/s" << setw(10) << "speedup"
+		<< setw(14) << "tree (ms)" << setw(12) << "Mjobs/s" << setw(10) << "speedup" << endl;
+
+	atomic<unsigned int> sink(0);
+	double baseFor = 0.0;
+	double baseTree = 0.0;
+
+	for(int threads = 1; threads <= maxThreads; threads++)
+	{
+		JobSystem system;
+		system.Start(threads - 1);
+
+		//	Warm up, then keep the best run to filter out noise
+		MeasureParallelFor(system, items, grain, sink);
+		double bestFor = 1e30;
+		double bestTree = 1e30;
+		for(int r = 0; r < repeats; r++)
+		{
+			const double forTime = MeasureParallelFor(system, items, grain, sink);
+			const double treeTime = MeasureTree(system, depth, sink);
+			if(forTime < bestFor)
+				bestFor = forTime;
+			if(treeTime < bestTree)
+				bestTree = treeTime;
+		}
+
+		if(threads == 1)
+		{
+			baseFor = bestFor;
+			baseTree = bestTree;
+		}
+
+		cout << setw(8) << threads << fixed
+			<< setw(14) << setprecision(2) << bestFor * 1000.0
+			<< setw(12) << setprecision(2) << rangeJobs / bestFor / 1e6
+			<< setw(10) << setprecision(2) << baseFor / bestFor
+			<< setw(14) << setprecision(2) << bestTree * 1000.0
+			<< setw(12) << setprecision(2) << treeJobs / bestTree / 1e6
+			<< setw(10) << setprecision(2) << baseTree / bestTree << endl;
+	}
+
+	//	Print the sink so the work can't be optimized out
+	cout << endl << "checksum " << sink.load() << endl;
+
+	return 0;
+}
@@ -0,0 +1,348 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#pragma endregion
+
+#pragma region System Includes
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "Protocol.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Session host load generator.
+ * Simulates thousands of clients, each with its own connection
+ * and one request in flight at a time: a new session, then
+ * guesses (with a status check every few of them) until the
+ * game is over, then a new session again.
+ * Clients are spread over a few threads, each driving its
+ * share through its own epoll loop. Reports the requests per
+ * second and the latency distribution, from the moment a
+ * request is sent to the moment its response is complete.
+ */
+
+#pragma region Constant Parameters
+#define DEFAULT_CLIENTS 4000
+#define DEFAULT_SECONDS 10
+#define DEFAULT_THREADS 4
+#define LOAD_MAX_EVENTS 256
+//	Guesses between two status checks
+#define GUESSES_PER_STATUS 4
+//	Latency histogram, one bucket per microsecond (slower requests share the last one)
+#define LATENCY_BUCKETS 100000
+#pragma endregion
+
+typedef struct
+{
+	int fd;
+	Uint32 session;
+	Uint16 charsetLength;
+	Uint8 codeLength;
+	Uint8 pending;		//	RequestType in flight
+	int guesses;
+	size_t received;
+	steady_clock::time_point sentAt;
+	SessionResponse response;
+} Client;
+
+typedef struct
+{
+	Uint64 requests;
+	Uint64 errors;
+	Uint64 games;
+	vector<Uint32> latencies;	//	Histogram, in microseconds
+} LoadResult;
+
+static Uint64 NextRandom(Uint64 & state)
+{
+	//	splitmix64
+	Uint64 z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static int Connect(const string & path)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if(path.size() >= sizeof(address.sun_path))
+		return -1;
+	memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	//	Connect blocking, retrying while the backlog is full, then switch to non-blocking
+	for(int attempt = 0; attempt < 1000; attempt++)
+	{
+		const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if(fd < 0)
+			return -1;
+		if(connect(fd, (sockaddr *)&address, sizeof(address)) == 0)
+		{
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+			return fd;
+		}
+		const int error = errno;
+		close(fd);
+		if(error != EAGAIN && error != EINTR)
+			return -1;
+		this_thread::sleep_for(milliseconds(1));
+	}
+
+	return -1;
+}
+
+static bool Send(Client & client, RequestType type, Uint64 & random)
+{
+	SessionRequest request;
+	memset(&request, 0, sizeof(request));
+	request.type = (Uint8)type;
+	request.session = client.session;
+	if(type == RequestType::SubmitCode)
+	{
+		request.codeLength = client.codeLength;
+		for(int d = 0; d < client.codeLength; d++)
+			request.code[d] = (CharIndex)(NextRandom(random) % client.charsetLength);
+	}
+
+	/*
+	 * A single small request on an otherwise idle connection:
+	 * the socket buffer always takes it whole, a short write
+	 * means the connection is gone.
+	 */
+	client.pending = request.type;
+	client.received = 0;
+	client.sentAt = steady_clock::now();
+	return send(client.fd, &request, sizeof(request), MSG_NOSIGNAL) == (ssize_t)sizeof(request);
+}
+
+static bool OnResponse(Client & client, LoadResult & result, Uint64 & random)
+{
+	const SessionResponse & response = client.response;
+	if(response.status != (Uint8)ResponseStatus::Ok)
+	{
+		//	Sessions may be reclaimed or exhausted, start over
+		result.errors++;
+		return Send(client, RequestType::NewSession, random);
+	}
+
+	switch((RequestType)response.type)
+	{
+		case RequestType::NewSession:
+			client.session = response.session;
+			client.charsetLength = response.charsetLength;
+			client.codeLength = response.codeLength;
+			client.guesses = 0;
+			return Send(client, RequestType::SubmitCode, random);
+
+		case RequestType::SubmitCode:
+		case RequestType::GetStatus:
+			if(response.flags & (SESSION_TIME_UP | SESSION_CLEARED))
+			{
+				result.games++;
+				return Send(client, RequestType::EndSession, random);
+			}
+			if(++client.guesses % GUESSES_PER_STATUS == 0)
+				return Send(client, RequestType::GetStatus, random);
+			return Send(client, RequestType::SubmitCode, random);
+
+		case RequestType::EndSession:
+			return Send(client, RequestType::NewSession, random);
+	}
+
+	return false;
+}
+
+static void RunClients(
+	const string & path, const int clientsCount, const int thread,
+	atomic<int> & ready, const int threads, const atomic<bool> & stop,
+	LoadResult & result
+)
+{
+	Uint64 random = 0xC11E47ULL + (Uint64)thread * 0x9E3779B97F4A7C15ULL;
+	result.latencies.assign(LATENCY_BUCKETS, 0);
+	vector<Client> clients(clientsCount);
+	const int epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+	//	Connect everybody first, the measure starts when all threads are done
+	for(int c = 0; c < clientsCount; c++)
+	{
+		Client & client = clients[c];
+		memset(&client.response, 0, sizeof(client.response));
+		client.session = 0;
+		client.fd = Connect(path);
+		if(client.fd < 0)
+		{
+			result.errors++;
+			continue;
+		}
+
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.u32 = (Uint32)c;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+	}
+	ready++;
+	while(ready.load() < threads)
+		this_thread::yield();
+
+	for(Client & client : clients)
+		if(client.fd >= 0 && !Send(client, RequestType::NewSession, random))
+			result.errors++;
+
+	epoll_event events[LOAD_MAX_EVENTS];
+	while(!stop.load(memory_order_relaxed))
+	{
+		const int count = epoll_wait(epollFd, events, LOAD_MAX_EVENTS, 10);
+		for(int e = 0; e < count; e++)
+		{
+			Client & client = clients[events[e].data.u32];
+			const ssize_t bytes = read(client.fd, (Uint8 *)&client.response + client.received, sizeof(SessionResponse) - client.received);
+			if(bytes < 0 && (errno == EAGAIN || errno == EINTR))
+				continue;
+			if(bytes <= 0)
+			{
+				result.errors++;
+				close(client.fd);
+				client.fd = -1;
+				continue;
+			}
+
+			client.received += (size_t)bytes;
+			if(client.received < sizeof(SessionResponse))
+				continue;
+
+			const Uint64 micros = (Uint64)duration_cast<microseconds>(steady_clock::now() - client.sentAt).count();
+			result.latencies[micros < LATENCY_BUCKETS ? micros : LATENCY_BUCKETS - 1]++;
+			result.requests++;
+
+			if(!OnResponse(client, result, random))
+			{
+				result.errors++;
+				close(client.fd);
+				client.fd = -1;
+			}
+		}
+	}
+
+	for(Client & client : clients)
+		if(client.fd >= 0)
+			close(client.fd);
+	close(epollFd);
+}
+
+static Uint64 GetPercentile(const vector<Uint32> & latencies, const Uint64 total, const double percentile)
+{
+	//	The 100th percentile is the last request, not one past it
+	const Uint64 rank = SDL_min((Uint64)(total * percentile / 100.0), total - 1);
+	Uint64 seen = 0;
+	for(size_t b = 0; b < latencies.size(); b++)
+	{
+		seen += latencies[b];
+		if(seen > rank)
+			return b;
+	}
+	return latencies.size() - 1;
+}
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	string socketPath = SESSION_DEFAULT_SOCKET;
+	int clientsCount = DEFAULT_CLIENTS;
+	int seconds = DEFAULT_SECONDS;
+	int threads = DEFAULT_THREADS;
+
+	for(int a = 1; a + 1 < argc; a += 2)
+	{
+		const string arg = argv[a];
+		const string value = argv[a + 1];
+		if(arg == "--socket")
+			socketPath = value;
+		else if(arg == "--clients")
+			clientsCount = atoi(value.c_str());
+		else if(arg == "--seconds")
+			seconds = atoi(value.c_str());
+		else if(arg == "--threads")
+			threads = atoi(value.c_str());
+		else
+			clientsCount = 0;	//	Unknown option, print usage
+	}
+	if(argc % 2 == 0 || clientsCount < 1 || seconds < 1 || threads < 1)
+	{
+		cout << "Usage: SessionLoad [--socket PATH] [--clients N] [--seconds N] [--threads N]" << endl;
+		return 1;
+	}
+	threads = SDL_min(threads, clientsCount);
+
+	//	One descriptor per client
+	rlimit limit;
+	if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	cout << "Driving " << clientsCount << " clients from " << threads << " threads for " << seconds << " s on " << socketPath << endl;
+
+	atomic<int> ready(0);
+	atomic<bool> stop(false);
+	vector<LoadResult> results(threads, LoadResult{0, 0, 0, vector<Uint32>()});
+	vector<thread> workers;
+	for(int t = 0; t < threads; t++)
+	{
+		const int share = clientsCount / threads + (t < clientsCount % threads ? 1 : 0);
+		workers.push_back(thread(RunClients, cref(socketPath), share, t, ref(ready), threads, cref(stop), ref(results[t])));
+	}
+
+	while(ready.load() < threads)
+		this_thread::sleep_for(milliseconds(1));
+	const steady_clock::time_point start = steady_clock::now();
+	this_thread::sleep_for(std::chrono::seconds(seconds));
+	stop = true;
+	for(thread & worker : workers)
+		worker.join();
+	const double elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+	//	Merge the threads results
+	LoadResult total = {0, 0, 0, vector<Uint32>(LATENCY_BUCKETS, 0)};
+	for(const LoadResult & result : results)
+	{
+		total.requests += result.requests;
+		total.errors += result.errors;
+		total.games += result.games;
+		for(size_t b = 0; b < result.latencies.size(); b++)
+			total.latencies[b] += result.latencies[b];
+	}
+
+	cout << fixed << setprecision(0);
+	cout << "Requests: " << total.requests << " in " << setprecision(2) << elapsed << " s ("
+		<< setprecision(0) << total.requests / elapsed << " requests/s)" << endl;
+	cout << "Games played: " << total.games << ", errors: " << total.errors << endl;
+	if(total.requests > 0)
+		cout << "Latency (us): p50 " << GetPercentile(total.latencies, total.requests, 50.0)
+			<< ", p90 " << GetPercentile(total.latencies, total.requests, 90.0)
+			<< ", p99 " << GetPercentile(total.latencies, total.requests, 99.0)
+			<< ", p99.9 " << GetPercentile(total.latencies, total.requests, 99.9)
+			<< ", max " << GetPercentile(total.latencies, total.requests, 100.0)
+			<< (total.latencies[LATENCY_BUCKETS - 1] > 0 ? "+" : "") << endl;
+
+	return 0;
+}
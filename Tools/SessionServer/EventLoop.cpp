@@ -0,0 +1,267 @@
+#include "EventLoop.h"
+
+#pragma region C++ Includes
+#include <chrono>
+#include <cstring>
+#pragma endregion
+
+#pragma region System Includes
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#pragma endregion
+
+#pragma region Constant Parameters
+#define LOOP_MAX_EVENTS 256
+//	Milliseconds, how often an idle loop checks for shutdown
+#define LOOP_WAIT_TIMEOUT 100
+//	Event tag of the listening socket
+#define LISTEN_TAG 0xFFFFFFFFu
+#pragma endregion
+
+using namespace std::chrono;
+
+static Uint64 GetMilliseconds()
+{
+	return (Uint64)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+EventLoop::EventLoop(const int loopIndex, const int listenSocket, const HostConfig & config) :
+	index(loopIndex),
+	listenFd(listenSocket),
+	maxConnections(config.connectionsPerLoop),
+	epollFd(-1),
+	sessions(
+		*config.charset, config.codeLength, config.stages, config.stageTime,
+		config.sessionsPerLoop, (Uint8)loopIndex, 0x5E5510ULL + (Uint64)loopIndex * 0x9E3779B97F4A7C15ULL
+	),
+	requests(0),
+	accepted(0)
+{
+	connections.reserve(maxConnections);
+	freeConnections.reserve(maxConnections);
+}
+
+EventLoop::~EventLoop()
+{
+	for(Connection & connection : connections)
+		if(connection.fd >= 0)
+			close(connection.fd);
+
+	if(epollFd >= 0)
+		close(epollFd);
+}
+
+bool EventLoop::Run(const atomic<bool> & stop)
+{
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if(epollFd < 0)
+		return false;
+
+	//	Every loop listens, only one of them is woken for each new client
+	epoll_event listenEvent = {};
+	listenEvent.events = EPOLLIN | EPOLLEXCLUSIVE;
+	listenEvent.data.u32 = LISTEN_TAG;
+	if(epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) < 0)
+		return false;
+
+	epoll_event events[LOOP_MAX_EVENTS];
+	while(!stop.load(memory_order_relaxed))
+	{
+		const int count = epoll_wait(epollFd, events, LOOP_MAX_EVENTS, LOOP_WAIT_TIMEOUT);
+		if(count < 0 && errno != EINTR)
+			return false;
+
+		//	One clock read for the whole batch
+		const Uint64 now = GetMilliseconds();
+		for(int e = 0; e < count; e++)
+		{
+			const Uint32 tag = events[e].data.u32;
+			if(tag == LISTEN_TAG)
+			{
+				Accept();
+				continue;
+			}
+
+			const Uint32 flags = events[e].events;
+			Connection & connection = connections[tag];
+			if(connection.fd < 0)
+				continue;
+			if(connection.blocked && (flags & (EPOLLHUP | EPOLLERR)))
+			{
+				Close(tag);
+				continue;
+			}
+			if(flags & EPOLLOUT)
+			{
+				//	The peer caught up: send the rest, then answer what was left
+				if(!Flush(tag) || connection.blocked)
+					continue;
+				Process(connection, now);
+				if(!Flush(tag))
+					continue;
+			}
+			if(flags & (EPOLLIN | EPOLLHUP | EPOLLERR))
+				Read(tag, now);
+		}
+	}
+
+	return true;
+}
+
+void EventLoop::Accept()
+{
+	for(;;)
+	{
+		const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(fd < 0)
+			return;	//	Drained, or another loop got it first
+
+		Uint32 c;
+		if(!freeConnections.empty())
+		{
+			c = freeConnections.back();
+			freeConnections.pop_back();
+		}
+		else if((int)connections.size() < maxConnections)
+		{
+			c = (Uint32)connections.size();
+			connections.emplace_back();
+		}
+		else
+		{
+			close(fd);
+			continue;
+		}
+
+		Connection & connection = connections[c];
+		connection.fd = fd;
+		connection.inUsed = 0;
+		connection.outUsed = 0;
+		connection.outSent = 0;
+		connection.blocked = false;
+
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.u32 = c;
+		if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+		{
+			Close(c);
+			continue;
+		}
+		accepted++;
+	}
+}
+
+void EventLoop::Close(const Uint32 c)
+{
+	Connection & connection = connections[c];
+	close(connection.fd);	//	Leaves the epoll set too
+	connection.fd = -1;
+	freeConnections.push_back(c);
+}
+
+void EventLoop::Read(const Uint32 c, const Uint64 now)
+{
+	Connection & connection = connections[c];
+
+	for(;;)
+	{
+		//	Answer what's buffered first, so there's always room to read into
+		Process(connection, now);
+		if(!Flush(c) || connection.blocked)
+			return;
+		if(connection.inUsed == sizeof(connection.in))
+			continue;
+
+		const ssize_t bytes = read(connection.fd, connection.in + connection.inUsed, sizeof(connection.in) - connection.inUsed);
+		if(bytes < 0 && errno == EINTR)
+			continue;
+		if(bytes < 0 && errno == EAGAIN)
+			return;
+		if(bytes <= 0)
+		{
+			Close(c);
+			return;
+		}
+
+		connection.inUsed += (size_t)bytes;
+	}
+}
+
+void EventLoop::Process(Connection & connection, const Uint64 now)
+{
+	//	Answer every complete request there's room for
+	size_t consumed = 0;
+	while(
+		connection.inUsed - consumed >= sizeof(SessionRequest) &&
+		connection.outUsed + sizeof(SessionResponse) <= sizeof(connection.out)
+	)
+	{
+		SessionRequest request;
+		SessionResponse response;
+		memcpy(&request, connection.in + consumed, sizeof(request));
+		sessions.Handle(request, response, now);
+		memcpy(connection.out + connection.outUsed, &response, sizeof(response));
+
+		consumed += sizeof(SessionRequest);
+		connection.outUsed += sizeof(SessionResponse);
+		requests++;
+	}
+
+	//	Keep the partial request at the front
+	if(consumed > 0)
+	{
+		memmove(connection.in, connection.in + consumed, connection.inUsed - consumed);
+		connection.inUsed -= consumed;
+	}
+}
+
+bool EventLoop::Flush(const Uint32 c)
+{
+	Connection & connection = connections[c];
+
+	while(connection.outSent < connection.outUsed)
+	{
+		const ssize_t bytes = send(connection.fd, connection.out + connection.outSent, connection.outUsed - connection.outSent, MSG_NOSIGNAL);
+		if(bytes < 0 && errno == EINTR)
+			continue;
+		if(bytes < 0 && errno == EAGAIN)
+		{
+			//	Stop reading until the peer makes room
+			if(!connection.blocked)
+			{
+				connection.blocked = true;
+				Watch(c, true);
+			}
+			return true;
+		}
+		if(bytes <= 0)
+		{
+			Close(c);
+			return false;
+		}
+		connection.outSent += (size_t)bytes;
+	}
+
+	connection.outUsed = 0;
+	connection.outSent = 0;
+
+	//	All sent, read again
+	if(connection.blocked)
+	{
+		connection.blocked = false;
+		Watch(c, false);
+	}
+	return true;
+}
+
+void EventLoop::Watch(const Uint32 c, const bool writable)
+{
+	epoll_event event = {};
+	event.events = writable ? EPOLLOUT : EPOLLIN;
+	event.data.u32 = c;
+	epoll_ctl(epollFd, EPOLL_CTL_MOD, connections[c].fd, &event);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <atomic>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Tool Includes
+#include "Protocol.h"
+#include "SessionTable.h"
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+//	Requests (and responses) a connection buffers at most
+#define CONNECTION_QUEUE 16
+#pragma endregion
+
+/*
+ * Game parameters every session is created with.
+ */
+typedef struct
+{
+	const Charset * charset;
+	Uint8 codeLength;
+	Uint8 stages;
+	Uint32 stageTime;	//	Milliseconds
+	int sessionsPerLoop;
+	int connectionsPerLoop;
+} HostConfig;
+
+/*
+ * One epoll loop, meant to run alone on its own core.
+ * All loops wait on the same listening socket (exclusively, so
+ * a new client wakes only one of them) and own everything else:
+ * their connections and the sessions created through them. No
+ * state is shared between loops, nothing is locked.
+ * Connections and their buffers come from a pool and requests are
+ * decoded and answered in place, so serving a request allocates
+ * nothing. A connection that doesn't read its responses stops
+ * being read until it does.
+ */
+class EventLoop
+{
+	// Fields
+public:
+protected:
+private:
+	typedef struct
+	{
+		int fd;
+		size_t inUsed;
+		size_t outUsed;
+		size_t outSent;
+		bool blocked;	//	Waiting for the peer to read, not reading
+		Uint8 in[CONNECTION_QUEUE * sizeof(SessionRequest)];
+		Uint8 out[CONNECTION_QUEUE * sizeof(SessionResponse)];
+	} Connection;
+
+	const int index;
+	const int listenFd;
+	const int maxConnections;
+	int epollFd;
+	SessionTable sessions;
+	vector<Connection> connections;
+	vector<Uint32> freeConnections;
+	Uint64 requests;
+	Uint64 accepted;
+	// Constructors
+public:
+	EventLoop(const int loopIndex, const int listenSocket, const HostConfig & config);
+	~EventLoop();
+	EventLoop(const EventLoop &) = delete;
+	EventLoop & operator=(const EventLoop &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Run(const atomic<bool> & stop);
+	__inline Uint64 GetRequests() const { return requests; }
+	__inline Uint64 GetAccepted() const { return accepted; }
+	__inline Uint64 GetSessionsCreated() const { return sessions.GetCreated(); }
+protected:
+private:
+	void Accept();
+	void Close(const Uint32 c);
+	void Read(const Uint32 c, const Uint64 now);
+	void Process(Connection & connection, const Uint64 now);
+	bool Flush(const Uint32 c);
+	void Watch(const Uint32 c, const bool writable);
+};
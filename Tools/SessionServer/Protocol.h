@@ -0,0 +1,75 @@
+#pragma once
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Charset.h"
+#pragma endregion
+
+/*
+ * Session host protocol.
+ * Clients and server exchange fixed-size binary messages over a
+ * local UNIX stream socket, one response for each request, in
+ * the same order. Fixed sizes make framing trivial and let both
+ * ends work on preallocated buffers. Both ends run on the same
+ * machine, so fields are in the native byte order.
+ * A session is served by the loop of the connection that created
+ * it: clients keep using that connection for it.
+ */
+
+#pragma region Constant Parameters
+#define SESSION_DEFAULT_SOCKET "/tmp/sdl-keypad-sessions.sock"
+#define PROTOCOL_MAX_CODE 16
+
+//	Response flags
+#define SESSION_CODE_MATCH 0x01		//	The submitted code was right
+#define SESSION_TIME_UP 0x02		//	The game is lost
+#define SESSION_CLEARED 0x04		//	The game is won
+#pragma endregion
+
+enum class RequestType : Uint8
+{
+	NewSession = 1,
+	SubmitCode,
+	GetStatus,
+	EndSession
+};
+
+enum class ResponseStatus : Uint8
+{
+	Ok,
+	UnknownSession,
+	NoSessionsLeft,
+	BadRequest
+};
+
+typedef struct
+{
+	Uint8 type;			//	RequestType
+	Uint8 codeLength;	//	SubmitCode only
+	Uint16 reserved;
+	Uint32 session;
+	Uint32 tag;			//	Echoed back as is
+	CharIndex code[PROTOCOL_MAX_CODE];	//	Charset slots, SubmitCode only
+} SessionRequest;
+
+typedef struct
+{
+	Uint8 type;			//	RequestType answered
+	Uint8 status;		//	ResponseStatus
+	Uint8 flags;
+	Uint8 stagesLeft;
+	Uint32 session;
+	Uint32 tag;
+	Uint32 timeLeft;	//	Milliseconds
+	Uint16 charsetLength;
+	Uint8 codeLength;
+	Uint8 reserved;
+	Uint8 digitErrors[PROTOCOL_MAX_CODE];	//	SubmitCode only, same as GameRules::EvaluateCodeError
+} SessionResponse;
+
+static_assert(sizeof(SessionRequest) == 44, "SessionRequest must have no padding");
+static_assert(sizeof(SessionResponse) == 36, "SessionResponse must have no padding");
@@ -0,0 +1,179 @@
+#include "SessionTable.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Session id layout: generation, loop, slot
+#define SESSION_SLOT_BITS 16
+#define SESSION_LOOP_BITS 8
+#define SESSION_MAX_CAPACITY (1 << SESSION_SLOT_BITS)
+#pragma endregion
+
+SessionTable::SessionTable(
+	const Charset & charset, const Uint8 codeLength,
+	const Uint8 stages, const Uint32 stageTimeMilliseconds,
+	const int capacity, const Uint8 loopIndex, const Uint64 seed
+) :
+	loop(loopIndex),
+	random(seed),
+	guess(codeLength, 0),
+	created(0)
+{
+	const int count = SDL_clamp(capacity, 1, SESSION_MAX_CAPACITY);
+	const GameRules rules(charset, codeLength, stages, stageTimeMilliseconds);
+
+	sessions.reserve(count);
+	freeSlots.reserve(count);
+	for(int s = 0; s < count; s++)
+	{
+		sessions.push_back({rules, 0, 0, false});
+		freeSlots.push_back((Uint16)(count - 1 - s));	//	Lower slots first
+	}
+}
+
+void SessionTable::Handle(const SessionRequest & request, SessionResponse & response, const Uint64 now)
+{
+	memset(&response, 0, sizeof(response));
+	response.type = request.type;
+	response.tag = request.tag;
+	response.session = request.session;
+	response.status = (Uint8)ResponseStatus::Ok;
+
+	switch((RequestType)request.type)
+	{
+		case RequestType::NewSession:
+		{
+			if(freeSlots.empty() && !Reclaim(now))
+			{
+				response.status = (Uint8)ResponseStatus::NoSessionsLeft;
+				return;
+			}
+
+			const Uint16 slot = freeSlots.back();
+			freeSlots.pop_back();
+			Session & session = sessions[slot];
+			session.rules.Restart(random);
+			session.start = now;
+			session.generation++;
+			session.active = true;
+			created++;
+
+			response.session = ((Uint32)session.generation << (SESSION_SLOT_BITS + SESSION_LOOP_BITS)) | ((Uint32)loop << SESSION_SLOT_BITS) | slot;
+			FillStatus(session, response, now);
+			return;
+		}
+
+		case RequestType::SubmitCode:
+		{
+			Session * session = Find(request.session);
+			if(!session)
+			{
+				response.status = (Uint8)ResponseStatus::UnknownSession;
+				return;
+			}
+
+			//	The rules index their tables by slot: reject anything they wouldn't expect
+			const GameRules & rules = session->rules;
+			bool valid = request.codeLength == rules.GetCodeLength() && request.codeLength <= PROTOCOL_MAX_CODE;
+			for(int d = 0; valid && d < request.codeLength; d++)
+				valid = request.code[d] < rules.GetCharsetLength();
+			if(!valid)
+			{
+				response.status = (Uint8)ResponseStatus::BadRequest;
+				return;
+			}
+
+			//	Same flow as the game: evaluate for hints, then submit (unless the game is over)
+			const Uint64 elapsed = now - session->start;
+			if(!rules.IsTimeUp(elapsed) && !rules.AreStagesCleared())
+			{
+				guess.assign(request.code, request.code + request.codeLength);
+				session->rules.EvaluateCodeError(guess, response.digitErrors);
+				if(session->rules.SubmitCode(guess, random))
+					response.flags |= SESSION_CODE_MATCH;
+			}
+
+			FillStatus(*session, response, now);
+			return;
+		}
+
+		case RequestType::GetStatus:
+		{
+			Session * session = Find(request.session);
+			if(!session)
+			{
+				response.status = (Uint8)ResponseStatus::UnknownSession;
+				return;
+			}
+
+			FillStatus(*session, response, now);
+			return;
+		}
+
+		case RequestType::EndSession:
+		{
+			Session * session = Find(request.session);
+			if(!session)
+			{
+				response.status = (Uint8)ResponseStatus::UnknownSession;
+				return;
+			}
+
+			session->active = false;
+			freeSlots.push_back((Uint16)(request.session & (SESSION_MAX_CAPACITY - 1)));
+			return;
+		}
+	}
+
+	response.status = (Uint8)ResponseStatus::BadRequest;
+}
+
+SessionTable::Session * SessionTable::Find(const Uint32 id)
+{
+	const Uint32 slot = id & (SESSION_MAX_CAPACITY - 1);
+	const Uint8 idLoop = (Uint8)(id >> SESSION_SLOT_BITS);
+	const Uint8 generation = (Uint8)(id >> (SESSION_SLOT_BITS + SESSION_LOOP_BITS));
+
+	if(idLoop != loop || slot >= sessions.size())
+		return nullptr;
+
+	Session & session = sessions[slot];
+	return session.active && session.generation == generation ? &session : nullptr;
+}
+
+bool SessionTable::Reclaim(const Uint64 now)
+{
+	/*
+	 * Out of sessions: clients that never ended theirs leave
+	 * them behind, free the ones whose game is over. Only
+	 * happens when the table is full, so the scan is rare.
+	 */
+	for(size_t s = 0; s < sessions.size(); s++)
+	{
+		Session & session = sessions[s];
+		if(session.active && (session.rules.IsTimeUp(now - session.start) || session.rules.AreStagesCleared()))
+		{
+			session.active = false;
+			freeSlots.push_back((Uint16)s);
+		}
+	}
+
+	return !freeSlots.empty();
+}
+
+void SessionTable::FillStatus(const Session & session, SessionResponse & response, const Uint64 now) const
+{
+	const GameRules & rules = session.rules;
+	const Uint64 elapsed = now - session.start;
+
+	response.stagesLeft = rules.GetStagesLeft();
+	response.timeLeft = rules.IsTimeUp(elapsed) ? 0 : (Uint32)(rules.GetSolveTime() - elapsed);
+	response.charsetLength = (Uint16)rules.GetCharsetLength();
+	response.codeLength = rules.GetCodeLength();
+	if(rules.IsTimeUp(elapsed))
+		response.flags |= SESSION_TIME_UP;
+	if(rules.AreStagesCleared())
+		response.flags |= SESSION_CLEARED;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "GameRules.h"
+#include "Charset.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "Protocol.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * A small and fast random source (splitmix64) for code
+ * generation, one per loop. It can be fed to GameRules as an
+ * index source.
+ */
+class SessionRandom
+{
+	// Fields
+private:
+	Uint64 state;
+	// Constructors
+public:
+	SessionRandom(Uint64 seed) : state(seed) { }
+	// Methods
+public:
+	__inline int operator()(const int length)
+	{
+		Uint64 z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return (int)(((z ^ (z >> 31)) >> 33) % (Uint64)length);
+	}
+};
+
+/*
+ * The sessions hosted by one loop. Each session runs the same
+ * GameRules the game uses, timed by the server clock (the role
+ * GameState plays in the game, without the HUD).
+ * All sessions are built upfront and recycled, and the guess
+ * buffer is reused: handling a request never allocates.
+ * Session ids carry the loop, the slot and a generation, so
+ * ids of ended sessions are rejected once their slot is reused.
+ * Only the owning loop thread may use it.
+ */
+class SessionTable
+{
+	// Fields
+public:
+protected:
+private:
+	typedef struct
+	{
+		GameRules rules;
+		Uint64 start;
+		Uint8 generation;
+		bool active;
+	} Session;
+
+	vector<Session> sessions;
+	vector<Uint16> freeSlots;
+	const Uint8 loop;
+	SessionRandom random;
+	Code guess;
+	Uint64 created;
+	// Constructors
+public:
+	SessionTable(
+		const Charset & charset, const Uint8 codeLength,
+		const Uint8 stages, const Uint32 stageTimeMilliseconds,
+		const int capacity, const Uint8 loopIndex, const Uint64 seed
+	);
+protected:
+private:
+	// Methods
+public:
+	void Handle(const SessionRequest & request, SessionResponse & response, const Uint64 now);
+	__inline Uint64 GetCreated() const { return created; }
+	__inline int GetActive() const { return (int)(sessions.size() - freeSlots.size()); }
+protected:
+private:
+	Session * Find(const Uint32 id);
+	bool Reclaim(const Uint64 now);
+	void FillStatus(const Session & session, SessionResponse & response, const Uint64 now) const;
+};
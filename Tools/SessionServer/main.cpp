@@ -0,0 +1,220 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#pragma endregion
+
+#pragma region System Includes
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sched.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Charset.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "Protocol.h"
+#include "EventLoop.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Session host.
+ * Runs the game rules authoritatively for many concurrent games,
+ * served to local clients over a UNIX domain socket with the
+ * binary protocol in Protocol.h. One epoll loop runs on each core,
+ * each owning its connections and sessions (see EventLoop).
+ * Runs until interrupted, then prints what it served.
+ */
+
+#pragma region Constant Parameters
+//	Defaults, matching the values shipped with the game
+#define DEFAULT_CHARSET "0123456789"
+#define DEFAULT_DIGITS 4
+#define DEFAULT_STAGES 3
+#define DEFAULT_SECONDS_PER_STAGE 60
+#define DEFAULT_SESSIONS_PER_LOOP 16384
+#define DEFAULT_CONNECTIONS_PER_LOOP 8192
+#define LISTEN_BACKLOG 4096
+
+#define TICKS_PER_SECOND 1000
+#pragma endregion
+
+static atomic<bool> stopRequested(false);
+
+static void OnSignal(int)
+{
+	stopRequested = true;
+}
+
+static int OpenListenSocket(const string & path)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if(path.size() >= sizeof(address.sun_path))
+		return -1;
+	memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(fd < 0)
+		return -1;
+
+	//	A socket file left behind by a previous run would make bind fail
+	unlink(path.c_str());
+	if(bind(fd, (sockaddr *)&address, sizeof(address)) < 0 || listen(fd, LISTEN_BACKLOG) < 0)
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static void RaiseFileLimit()
+{
+	//	Thousands of clients need thousands of descriptors
+	rlimit limit;
+	if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+}
+
+static void PinToCore(const int core)
+{
+	cpu_set_t cores;
+	CPU_ZERO(&cores);
+	CPU_SET(core, &cores);
+	pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+}
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	string socketPath = SESSION_DEFAULT_SOCKET;
+	string symbols = DEFAULT_CHARSET;
+	//	May be unknown (0), one loop per core otherwise
+	const int cores = SDL_max((int)thread::hardware_concurrency(), 1);
+	int loops = cores;
+	int digits = DEFAULT_DIGITS;
+	int stages = DEFAULT_STAGES;
+	int seconds = DEFAULT_SECONDS_PER_STAGE;
+	int sessionsPerLoop = DEFAULT_SESSIONS_PER_LOOP;
+	int connectionsPerLoop = DEFAULT_CONNECTIONS_PER_LOOP;
+
+	for(int a = 1; a + 1 < argc; a += 2)
+	{
+		const string arg = argv[a];
+		const string value = argv[a + 1];
+		if(arg == "--socket")
+			socketPath = value;
+		else if(arg == "--threads")
+			loops = atoi(value.c_str());
+		else if(arg == "--charset")
+			symbols = value;
+		else if(arg == "--digits")
+			digits = atoi(value.c_str());
+		else if(arg == "--stages")
+			stages = atoi(value.c_str());
+		else if(arg == "--seconds")
+			seconds = atoi(value.c_str());
+		else if(arg == "--sessions")
+			sessionsPerLoop = atoi(value.c_str());
+		else if(arg == "--connections")
+			connectionsPerLoop = atoi(value.c_str());
+		else
+			digits = 0;	//	Unknown option, print usage
+	}
+
+	const Charset charset(symbols);
+	if(
+		argc % 2 == 0 ||
+		charset.IsEmpty() ||
+		digits < 1 || digits > PROTOCOL_MAX_CODE ||
+		stages < 1 || stages > 255 ||
+		seconds < 1 ||
+		sessionsPerLoop < 1 || connectionsPerLoop < 1
+	)
+	{
+		cout << "Usage: SessionServer [--socket PATH] [--threads N] [--charset STRING] [--digits N] [--stages N] [--seconds N] [--sessions N] [--connections N]" << endl;
+		return 1;
+	}
+	loops = SDL_clamp(loops, 1, 256);
+
+	RaiseFileLimit();
+	signal(SIGINT, OnSignal);
+	signal(SIGTERM, OnSignal);
+	signal(SIGPIPE, SIG_IGN);
+
+	const int listenFd = OpenListenSocket(socketPath);
+	if(listenFd < 0)
+	{
+		cout << "Can't listen on " << socketPath << ": " << strerror(errno) << endl;
+		return 1;
+	}
+
+	const HostConfig config = {
+		&charset,
+		(Uint8)digits,
+		(Uint8)stages,
+		(Uint32)seconds * TICKS_PER_SECOND,
+		sessionsPerLoop,
+		connectionsPerLoop
+	};
+
+	cout << "Hosting " << sessionsPerLoop << " sessions x " << loops << " loops on " << socketPath
+		<< " (" << digits << " digits, " << stages << " stages, " << seconds << " s per stage)" << endl;
+
+	//	Each loop is built by its own thread, so its memory is local to its core
+	vector<unique_ptr<EventLoop>> eventLoops(loops);
+	vector<thread> workers;
+	atomic<int> failed(0);
+	for(int l = 0; l < loops; l++)
+		workers.push_back(thread([&, l]()
+		{
+			PinToCore(l % cores);
+			eventLoops[l].reset(new EventLoop(l, listenFd, config));
+			if(!eventLoops[l]->Run(stopRequested))
+			{
+				failed++;
+				stopRequested = true;
+			}
+		}));
+	for(thread & worker : workers)
+		worker.join();
+
+	close(listenFd);
+	unlink(socketPath.c_str());
+
+	Uint64 requests = 0;
+	Uint64 accepted = 0;
+	Uint64 created = 0;
+	for(const unique_ptr<EventLoop> & loop : eventLoops)
+	{
+		requests += loop->GetRequests();
+		accepted += loop->GetAccepted();
+		created += loop->GetSessionsCreated();
+	}
+	cout << endl << "Served " << requests << " requests, " << created << " sessions, " << accepted << " connections" << endl;
+
+	if(failed > 0)
+	{
+		cout << failed.load() << " event loops failed" << endl;
+		return 1;
+	}
+
+	return 0;
+}
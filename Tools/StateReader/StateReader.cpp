@@ -0,0 +1,96 @@
+#include "StateReader.h"
+
+#pragma region C++ Includes
+#include <cstring>
+#pragma endregion
+
+#pragma region System Includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Publications overlapping a read before giving up on it
+#define STATE_READ_ATTEMPTS 64
+#pragma endregion
+
+StateReader::StateReader() :
+	segment(nullptr)
+{ }
+
+StateReader::~StateReader()
+{
+	Close();
+}
+
+bool StateReader::Open(const string & segmentName)
+{
+	Close();
+
+	const int fd = shm_open(segmentName.c_str(), O_RDONLY, 0);
+	if(fd < 0)
+		return false;
+
+	//	A segment from another build (or still being created) isn't ours to read
+	struct stat info;
+	void * memory = MAP_FAILED;
+	if(fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(SharedStateSegment))
+		memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(memory == MAP_FAILED)
+		return false;
+
+	segment = (const SharedStateSegment *)memory;
+	if(!IsGameRunning() || segment->version != SHARED_STATE_VERSION)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void StateReader::Close()
+{
+	if(!segment)
+		return;
+
+	munmap((void *)segment, sizeof(SharedStateSegment));
+	segment = nullptr;
+}
+
+bool StateReader::IsGameRunning() const
+{
+	//	The game clears the magic when it closes the segment
+	if(!segment)
+		return false;
+
+	const Uint32 magic = segment->magic;
+	atomic_thread_fence(memory_order_acquire);
+	return magic == SHARED_STATE_MAGIC;
+}
+
+bool StateReader::Read(SharedGameState & state) const
+{
+	if(!IsGameRunning())
+		return false;
+
+	for(int attempt = 0; attempt < STATE_READ_ATTEMPTS; attempt++)
+	{
+		//	Odd means the game is writing right now
+		const Uint32 before = segment->sequence.load(memory_order_acquire);
+		if(before & 1)
+			continue;
+
+		memcpy(&state, &segment->state, sizeof(state));
+		atomic_thread_fence(memory_order_acquire);
+
+		//	Unchanged sequence: nothing was written while copying
+		if(segment->sequence.load(memory_order_relaxed) == before)
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <string>
+#pragma endregion
+
+#pragma region SDL Includes
+//	SDL Core (types only)
+#include <SDL_stdinc.h>
+#pragma endregion
+
+#pragma region Game Includes
+#include "SharedState.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Reads the state the game publishes to shared memory when run
+ * with --share-state (see SharedState.h).
+ * Reading never disturbs the game: a read that overlaps a
+ * publication is simply retried, a few times at most.
+ * Link this library into any overlay or spectator process.
+ */
+class StateReader
+{
+	// Fields
+public:
+protected:
+private:
+	const SharedStateSegment * segment;
+	// Constructors
+public:
+	StateReader();
+	~StateReader();
+	StateReader(const StateReader &) = delete;
+	StateReader & operator=(const StateReader &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Open(const string & segmentName = SHARED_STATE_NAME);
+	void Close();
+	__inline bool IsOpen() const { return segment != nullptr; }
+	bool IsGameRunning() const;
+	bool Read(SharedGameState & state) const;
+protected:
+private:
+};
@@ -0,0 +1,114 @@
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#pragma endregion
+
+#pragma region Game Includes
+#include "SharedState.h"
+#include "Charset.h"
+#pragma endregion
+
+#pragma region Tool Includes
+#include "StateReader.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Example spectator, the smallest possible stream overlay.
+ * Waits for a game running with --share-state and prints a line
+ * each time its state changes: stages, time left, the input code
+ * and its hints.
+ */
+
+#pragma region Constant Parameters
+#define DEFAULT_INTERVAL 100
+#pragma endregion
+
+static void PrintState(const SharedGameState & state)
+{
+	static const char * hintNames[] = {"", " (ok)", " (close)", " (wrong)"};
+	static const char * statusNames[] = {"playing", "won", "lost"};
+
+	cout << "stage " << (int)(state.stages - state.stagesLeft + (state.stagesLeft > 0 ? 1 : 0)) << "/" << (int)state.stages
+		<< "  " << setw(3) << state.timeLeft / 1000 << "." << (state.timeLeft % 1000) / 100 << " s left  ";
+
+	//	Print the input digits, placeholders for the missing ones
+	char utf8[4];
+	for(int d = 0; d < state.codeLength; d++)
+	{
+		if(d < state.inputLength)
+		{
+			cout.write(utf8, Charset::EncodeUtf8(state.input[d], utf8));
+			cout << hintNames[state.hints[d] <= SHARED_HINT_WRONG ? state.hints[d] : 0];
+		}
+		else
+			cout << "_";
+		cout << " ";
+	}
+
+	cout << " " << (state.status <= SHARED_STATUS_LOST ? statusNames[state.status] : "?") << endl;
+}
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	string segmentName = SHARED_STATE_NAME;
+	int interval = DEFAULT_INTERVAL;
+
+	for(int a = 1; a + 1 < argc; a += 2)
+	{
+		const string arg = argv[a];
+		if(arg == "--segment")
+			segmentName = argv[a + 1];
+		else if(arg == "--interval")
+			interval = atoi(argv[a + 1]);
+		else
+			interval = 0;	//	Unknown option, print usage
+	}
+	if(argc % 2 == 0 || interval < 1)
+	{
+		cout << "Usage: StateSpectator [--segment NAME] [--interval MS]" << endl;
+		return 1;
+	}
+
+	StateReader reader;
+	SharedGameState state;
+	SharedGameState shown;
+	bool waiting = false;
+	bool hasShown = false;
+	for(;;)
+	{
+		//	(Re)attach when the game starts, or starts again
+		if(!reader.IsGameRunning() && !reader.Open(segmentName))
+		{
+			if(!waiting)
+				cout << "Waiting for the game (run it with --share-state)..." << endl;
+			waiting = true;
+			hasShown = false;
+		}
+		else if(reader.Read(state))
+		{
+			waiting = false;
+
+			//	Only print changes: everything but the frame counter
+			state.frame = 0;
+			if(!hasShown || memcmp(&state, &shown, sizeof(state)) != 0)
+			{
+				PrintState(state);
+				shown = state;
+				hasShown = true;
+			}
+		}
+
+		this_thread::sleep_for(milliseconds(interval));
+	}
+
+	return 0;
+}